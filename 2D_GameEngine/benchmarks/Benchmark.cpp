@@ -0,0 +1,263 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <regex>
+#include <thread>
+#include <utility>
+
+namespace bench {
+
+namespace {
+
+std::vector<std::unique_ptr<Benchmark>>& registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+std::vector<std::pair<std::string, std::string>>& customContext() {
+    static std::vector<std::pair<std::string, std::string>> context;
+    return context;
+}
+
+struct Options {
+    std::string filter = ".*";
+    double minTime = 0.5; // seconds
+    bool json = false;
+    std::string outFile;
+};
+
+struct Result {
+    std::string name;
+    int64_t iterations = 0;
+    double realNs = 0.0; // per iteration
+    double cpuNs = 0.0;
+    double itemsPerSecond = 0.0;
+    std::string label;
+    std::string error;
+};
+
+bool parseFlag(const char* arg, const char* name, std::string& value) {
+    size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=') return false;
+    value = arg + n + 1;
+    return true;
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: benchmarks [--benchmark_filter=REGEX] [--benchmark_min_time=SECONDS]\n"
+        "                  [--benchmark_format=console|json] [--benchmark_out=FILE]\n"
+        "                  [--benchmark_list_tests]\n");
+}
+
+std::string runName(const Benchmark& b, const std::vector<int64_t>& args) {
+    std::string name = b.name;
+    for (int64_t a : args) name += "/" + std::to_string(a);
+    return name;
+}
+
+Result run(const Benchmark& b, const std::vector<int64_t>& args, double minTime) {
+    Result r;
+    r.name = runName(b, args);
+
+    int64_t iterations = 1;
+    for (;;) {
+        State state(iterations, args);
+        b.fn(state);
+
+        double seconds = state.realNs / 1e9;
+        if (!state.error.empty() || seconds >= minTime || iterations >= 1000000000) {
+            r.iterations = iterations;
+            r.realNs = iterations > 0 ? state.realNs / iterations : 0.0;
+            r.cpuNs = iterations > 0 ? state.cpuNs / iterations : 0.0;
+            if (state.itemsProcessed > 0 && state.realNs > 0.0) {
+                r.itemsPerSecond = state.itemsProcessed / seconds;
+            }
+            r.label = state.label;
+            r.error = state.error;
+            return r;
+        }
+
+        // Aim past the minimum time, growing at most 10x per attempt
+        double multiplier = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+        multiplier = std::min(multiplier, 10.0);
+        int64_t next = static_cast<int64_t>(iterations * multiplier);
+        iterations = std::max(next, iterations + 1);
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+                else out += c;
+        }
+    }
+    return out;
+}
+
+void writeJson(std::FILE* f, const std::vector<Result>& results, const char* executable) {
+    char date[64] = "";
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(f, "{\n  \"context\": {\n");
+    std::fprintf(f, "    \"date\": \"%s\",\n", date);
+    std::fprintf(f, "    \"executable\": \"%s\",\n", jsonEscape(executable).c_str());
+    std::fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    for (const auto& [key, value] : customContext()) {
+        std::fprintf(f, "    \"%s\": \"%s\",\n", jsonEscape(key).c_str(), jsonEscape(value).c_str());
+    }
+#ifdef NDEBUG
+    std::fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(f, "  },\n  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n",
+                     jsonEscape(r.name).c_str(), jsonEscape(r.name).c_str());
+        if (!r.error.empty()) {
+            std::fprintf(f, "      \"error_occurred\": true,\n      \"error_message\": \"%s\"\n",
+                         jsonEscape(r.error).c_str());
+        } else {
+            std::fprintf(f, "      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n"
+                            "      \"time_unit\": \"ns\"",
+                         static_cast<long long>(r.iterations), r.realNs, r.cpuNs);
+            if (r.itemsPerSecond > 0.0) std::fprintf(f, ",\n      \"items_per_second\": %.3f", r.itemsPerSecond);
+            if (!r.label.empty()) std::fprintf(f, ",\n      \"label\": \"%s\"", jsonEscape(r.label).c_str());
+            std::fprintf(f, "\n");
+        }
+        std::fprintf(f, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+
+void printConsoleHeader() {
+    std::printf("%-44s %14s %14s %12s  %s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations", "Items/s");
+    std::printf("%s\n", std::string(100, '-').c_str());
+}
+
+void printConsole(const Result& r) {
+    if (!r.error.empty()) {
+        std::printf("%-44s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+    } else {
+        std::printf("%-44s %14.1f %14.1f %12lld", r.name.c_str(), r.realNs, r.cpuNs,
+                    static_cast<long long>(r.iterations));
+        if (r.itemsPerSecond > 0.0) std::printf("  %.4g", r.itemsPerSecond);
+        if (!r.label.empty()) std::printf("  %s", r.label.c_str());
+        std::printf("\n");
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+void State::start() {
+    started = true;
+    realStart = std::chrono::steady_clock::now();
+    cpuStart = std::clock();
+}
+
+void State::pauseTiming() {
+    if (paused) return;
+    realNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - realStart).count();
+    cpuNs += 1e9 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    paused = true;
+}
+
+void State::resumeTiming() {
+    if (!paused) return;
+    paused = false;
+    realStart = std::chrono::steady_clock::now();
+    cpuStart = std::clock();
+}
+
+void State::finish() {
+    if (!paused) pauseTiming();
+}
+
+Benchmark* registerBenchmark(const char* name, Function fn) {
+    registry().push_back(std::make_unique<Benchmark>(name, fn));
+    return registry().back().get();
+}
+
+void addCustomContext(const std::string& key, const std::string& value) {
+    customContext().emplace_back(key, value);
+}
+
+int runAll(int argc, char* argv[]) {
+    Options options;
+    bool listOnly = false;
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (parseFlag(argv[i], "--benchmark_filter", value)) {
+            options.filter = value;
+        } else if (parseFlag(argv[i], "--benchmark_min_time", value)) {
+            // Google Benchmark accepts a trailing "s"
+            options.minTime = std::atof(value.c_str());
+        } else if (parseFlag(argv[i], "--benchmark_format", value)) {
+            options.json = value == "json";
+        } else if (parseFlag(argv[i], "--benchmark_out", value)) {
+            options.outFile = value;
+        } else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) {
+            listOnly = true;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::regex filter;
+    try {
+        filter = std::regex(options.filter);
+    } catch (const std::regex_error&) {
+        std::fprintf(stderr, "Invalid --benchmark_filter: %s\n", options.filter.c_str());
+        return 1;
+    }
+
+    std::vector<Result> results;
+    if (!options.json && !listOnly) printConsoleHeader();
+    for (const auto& b : registry()) {
+        std::vector<std::vector<int64_t>> argSets = b->argSets;
+        if (argSets.empty()) argSets.push_back({});
+        for (const auto& args : argSets) {
+            std::string name = runName(*b, args);
+            if (!std::regex_search(name, filter)) continue;
+            if (listOnly) {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+            results.push_back(run(*b, args, options.minTime));
+            if (!options.json) printConsole(results.back());
+        }
+    }
+    if (listOnly) return 0;
+
+    if (options.json) writeJson(stdout, results, argv[0]);
+    if (!options.outFile.empty()) {
+        std::FILE* f = std::fopen(options.outFile.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "Cannot write %s\n", options.outFile.c_str());
+            return 1;
+        }
+        writeJson(f, results, argv[0]);
+        std::fclose(f);
+    }
+
+    bool failed = std::any_of(results.begin(), results.end(), [](const Result& r) { return !r.error.empty(); });
+    return failed ? 1 : 0;
+}
+
+} // namespace bench
@@ -0,0 +1,127 @@
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+
+/**
+ * @brief Minimal in-tree benchmark harness modelled on Google Benchmark.
+ *
+ * Register a function with BENCHMARK(fn)->Arg(...), loop on
+ * state.keepRunning() and the runner picks an iteration count that fills
+ * the minimum time. Command-line flags and the JSON output follow Google
+ * Benchmark's names and schema (--benchmark_filter, --benchmark_min_time,
+ * --benchmark_format, --benchmark_out), so existing comparison tooling
+ * works on the results.
+ */
+namespace bench {
+
+class State {
+public:
+    State(int64_t iterations, const std::vector<int64_t>& args) : maxIterations(iterations), args(args) {}
+
+    /**
+     * @brief True while more iterations should run; starts the timer on the first call.
+     */
+    bool keepRunning() {
+        if (done == 0 && !started) start();
+        if (done < maxIterations) {
+            done++;
+            return true;
+        }
+        finish();
+        return false;
+    }
+
+    int64_t range(size_t index = 0) const { return index < args.size() ? args[index] : 0; }
+    int64_t iterations() const { return maxIterations; }
+
+    // Exclude setup work inside the loop from the measurement
+    void pauseTiming();
+    void resumeTiming();
+
+    void setItemsProcessed(int64_t items) { itemsProcessed = items; }
+    void setLabel(const std::string& text) { label = text; }
+    void skipWithError(const std::string& message) {
+        error = message;
+        maxIterations = done; // ends the loop at the next keepRunning()
+    }
+
+    // Results, filled in by the loop
+    double realNs = 0.0;
+    double cpuNs = 0.0;
+    int64_t itemsProcessed = 0;
+    std::string label;
+    std::string error;
+
+private:
+    void start();
+    void finish();
+
+    int64_t maxIterations;
+    int64_t done = 0;
+    bool started = false;
+    bool paused = false;
+    std::vector<int64_t> args;
+
+    std::chrono::steady_clock::time_point realStart;
+    std::clock_t cpuStart = 0;
+};
+
+using Function = void (*)(State&);
+
+class Benchmark {
+public:
+    Benchmark(const char* name, Function fn) : name(name), fn(fn) {}
+
+    Benchmark* Arg(int64_t value) {
+        argSets.push_back({value});
+        return this;
+    }
+    Benchmark* Args(const std::vector<int64_t>& values) {
+        argSets.push_back(values);
+        return this;
+    }
+
+    std::string name;
+    Function fn;
+    std::vector<std::vector<int64_t>> argSets;
+};
+
+Benchmark* registerBenchmark(const char* name, Function fn);
+
+/**
+ * @brief Extra key/value written to the "context" block of the JSON output.
+ */
+void addCustomContext(const std::string& key, const std::string& value);
+
+/**
+ * @brief Run the registered benchmarks; returns the process exit code.
+ */
+int runAll(int argc, char* argv[]);
+
+/**
+ * @brief Keep the compiler from discarding a computed value.
+ */
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+#define BENCHMARK(fn) \
+    static ::bench::Benchmark* BENCHMARK_CONCAT(benchmark_registration_, __LINE__) = \
+        ::bench::registerBenchmark(#fn, fn)
+
+#endif /* Benchmark_hpp */
@@ -0,0 +1,398 @@
+// Micro-benchmarks for the simulation hot paths and headless macro
+// scenarios. Build the `benchmarks` target in Release and run e.g.
+//
+//   benchmarks --benchmark_format=json --benchmark_out=results.json
+//
+// BM_MapDrawMap needs the assets directory in the working directory.
+
+#include "Benchmark.hpp"
+#include "Level.hpp"
+#include "LevelSnapshot.hpp"
+#include "TowerFactory.h"
+#include "Map.hpp"
+#include "StatusEffects.hpp"
+#include "CommandBuffer.hpp"
+#include "EnemyMotion.hpp"
+#include "FlowField.hpp"
+#include "SpatialGrid.hpp"
+#include "Random.hpp"
+#include "Utils.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+#include <memory>
+#include <vector>
+#include <string>
+
+namespace {
+
+constexpr float WORLD_W = Map::DEFAULT_COLS * Map::TILE_SIZE;
+constexpr float WORLD_H = Map::DEFAULT_ROWS * Map::TILE_SIZE;
+
+std::vector<std::unique_ptr<Enemy>> makeEnemies(size_t count, uint64_t seed) {
+    Random rng(seed);
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    enemies.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int x = rng.range(0, static_cast<int>(WORLD_W) - 1);
+        int y = rng.range(0, static_cast<int>(WORLD_H) - 1);
+        enemies.push_back(i % 2 ? Enemy::createOrc(nullptr, x, y) : Enemy::createGoblin(nullptr, x, y));
+    }
+    return enemies;
+}
+
+// Shrugs off every hit, so a Level benchmark keeps all its towers and
+// simulates the same work every tick (BM_LevelSiege covers tower losses)
+class SturdyTower : public Tower {
+public:
+    using Tower::Tower;
+    void takeDamage(int) override {}
+};
+
+std::vector<std::unique_ptr<Tower>> makeTowers(size_t count) {
+    // Spread over the grid, one tower per tile
+    std::vector<std::unique_ptr<Tower>> towers;
+    towers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int col = static_cast<int>((i * 7) % Map::DEFAULT_COLS);
+        int row = static_cast<int>((i * 7 / Map::DEFAULT_COLS * 3 + i) % Map::DEFAULT_ROWS);
+        towers.push_back(std::make_unique<SturdyTower>(Point2D(col * 32.0f, row * 32.0f), 15, 150.0f, nullptr));
+    }
+    return towers;
+}
+
+// --- Target acquisition -----------------------------------------------------
+
+void BM_UtilsFindNearest(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 1);
+    auto towers = makeTowers(16);
+    while (state.keepRunning()) {
+        for (const auto& t : towers) {
+            bench::doNotOptimize(Utils::findNearest<Enemy>(*t, enemies, t->getRange()));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<int64_t>(towers.size()));
+}
+BENCHMARK(BM_UtilsFindNearest)->Arg(64)->Arg(256)->Arg(1024);
+
+// Rebuild + queries, as Level does every tick
+void BM_SpatialGridFindNearest(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 1);
+    auto towers = makeTowers(16);
+    SpatialGrid<Enemy> grid(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE);
+    while (state.keepRunning()) {
+        grid.rebuild(enemies);
+        for (const auto& t : towers) {
+            bench::doNotOptimize(grid.findNearest(*t, t->getRange()));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<int64_t>(towers.size()));
+}
+BENCHMARK(BM_SpatialGridFindNearest)->Arg(64)->Arg(256)->Arg(1024);
+
+// --- Enemy movement and effects ---------------------------------------------
+
+void BM_EnemyUpdate(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 2);
+    for (auto& e : enemies) e->setTarget(1e6f, 1e6f); // never arrives
+    while (state.keepRunning()) {
+        for (auto& e : enemies) e->update();
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EnemyUpdate)->Arg(64)->Arg(256)->Arg(1024)->Arg(100000);
+
+void BM_EnemyMotionStep(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 2);
+    for (auto& e : enemies) e->setTarget(400.0f, 300.0f);
+
+    // The batched kernel must match Enemy::move() bit for bit, or the numbers mean nothing
+    auto reference = makeEnemies(static_cast<size_t>(state.range(0)), 2);
+    for (auto& e : reference) {
+        e->setTarget(400.0f, 300.0f);
+        e->move();
+    }
+    EnemyMotion motion;
+    motion.load(enemies);
+    motion.step();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        if (motion.x[i] != reference[i]->getX() || motion.y[i] != reference[i]->getY()) {
+            state.skipWithError("EnemyMotion result differs from Enemy::move");
+            break;
+        }
+    }
+
+    while (state.keepRunning()) {
+        motion.load(enemies);
+        motion.step();
+        motion.store();
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+    state.setLabel(EnemyMotion::simdName());
+}
+BENCHMARK(BM_EnemyMotionStep)->Arg(64)->Arg(256)->Arg(1024)->Arg(100000);
+
+// The kernel alone, on arrays loaded once: the difference to BM_EnemyMotionStep
+// is the per-tick gather from and scatter back to the Enemy objects
+void BM_EnemyMotionKernel(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 2);
+    for (auto& e : enemies) e->setTarget(1e6f, 1e6f); // never arrives
+    EnemyMotion motion;
+    motion.load(enemies);
+    while (state.keepRunning()) {
+        motion.step();
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+    state.setLabel(EnemyMotion::simdName());
+}
+BENCHMARK(BM_EnemyMotionKernel)->Arg(1024)->Arg(100000);
+
+void BM_StatusEffectsUpdate(bench::State& state) {
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 3);
+    StatusEffects effects;
+    CommandBuffer commands; // stays empty: burns of 0 kill nothing
+    for (auto& e : enemies) {
+        // Long-lived and harmless, so every iteration does the same work
+        effects.addSlow(*e, 1 << 30, 0.5f);
+        effects.addBurn(*e, 1 << 30, 0);
+    }
+    while (state.keepRunning()) {
+        effects.update(commands);
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StatusEffectsUpdate)->Arg(64)->Arg(256)->Arg(1024);
+
+// --- Pathfinding -----------------------------------------------------------
+
+std::unique_ptr<Map> makeHeadlessMap() {
+    // Grass with the default path on row 10
+    auto map = std::make_unique<Map>(nullptr);
+    Grid2D<int> tiles(Map::DEFAULT_ROWS, Map::DEFAULT_COLS, 0);
+    for (int c = 0; c < Map::DEFAULT_COLS; ++c) tiles.set(10, c, 1);
+    map->LoadMap(tiles);
+    return map;
+}
+
+std::vector<int> towerTiles(const FlowField& field, size_t count) {
+    std::vector<int> goals;
+    for (const auto& t : makeTowers(count)) goals.push_back(field.tileAt(t->getX(), t->getY()));
+    return goals;
+}
+
+// Full Dijkstra, paid when a tower is removed or tiles change
+void BM_FlowFieldRebuild(bench::State& state) {
+    auto map = makeHeadlessMap();
+    FlowField field(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE);
+    auto goals = towerTiles(field, static_cast<size_t>(state.range(0)));
+    while (state.keepRunning()) {
+        field.rebuild(*map, goals);
+        bench::doNotOptimize(field.getDistance(0));
+    }
+}
+BENCHMARK(BM_FlowFieldRebuild)->Arg(1)->Arg(16);
+
+// Per-enemy cost of following the field
+void BM_FlowFieldNextTile(bench::State& state) {
+    auto map = makeHeadlessMap();
+    FlowField field(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE);
+    field.rebuild(*map, towerTiles(field, 4));
+    auto enemies = makeEnemies(static_cast<size_t>(state.range(0)), 5);
+    while (state.keepRunning()) {
+        for (const auto& e : enemies) {
+            bench::doNotOptimize(field.nextTile(field.tileAt(e->getX(), e->getY())));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlowFieldNextTile)->Arg(256)->Arg(4096);
+
+// --- Headless macro scenarios -----------------------------------------------
+
+// towers x enemies, TICKS ticks from a fresh level per iteration
+void BM_LevelUpdate(bench::State& state) {
+    constexpr int TICKS = 300;
+    const size_t towerCount = static_cast<size_t>(state.range(0));
+    const size_t enemyCount = static_cast<size_t>(state.range(1));
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        auto level = std::make_unique<Level>(nullptr, 1, Random::DEFAULT_SEED);
+        level->loadDefaultMap();
+        for (auto& t : makeTowers(towerCount)) level->addTower(std::move(t));
+        for (auto& e : makeEnemies(enemyCount, 4)) level->spawnEnemy(std::move(e));
+        state.resumeTiming();
+
+        for (int i = 0; i < TICKS; ++i) level->update();
+        bench::doNotOptimize(level->getEnemyCount());
+
+        state.pauseTiming();
+        level.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * TICKS);
+}
+BENCHMARK(BM_LevelUpdate)->Args({4, 64})->Args({16, 256})->Args({64, 1024})->Args({64, 4096});
+
+// Same, with the AI query passes on a pool; arg 2: workers (0 = one per core)
+void BM_LevelUpdateThreaded(bench::State& state) {
+    constexpr int TICKS = 300;
+    const size_t towerCount = static_cast<size_t>(state.range(0));
+    const size_t enemyCount = static_cast<size_t>(state.range(1));
+    ThreadPool pool(static_cast<size_t>(state.range(2)));
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        auto level = std::make_unique<Level>(nullptr, 1, Random::DEFAULT_SEED);
+        level->setThreadPool(&pool);
+        level->loadDefaultMap();
+        for (auto& t : makeTowers(towerCount)) level->addTower(std::move(t));
+        for (auto& e : makeEnemies(enemyCount, 4)) level->spawnEnemy(std::move(e));
+        state.resumeTiming();
+
+        for (int i = 0; i < TICKS; ++i) level->update();
+        bench::doNotOptimize(level->getEnemyCount());
+
+        state.pauseTiming();
+        level.reset();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * TICKS);
+}
+BENCHMARK(BM_LevelUpdateThreaded)->Args({64, 1024, 0})->Args({64, 4096, 0});
+
+// A whole level under siege (as in assets/waves_siege.txt) until the
+// towers fall: exercises tower kills, flow-field rebuilds and the loss
+void BM_LevelSiege(bench::State& state) {
+    WaveDef siege;
+    siege.startTick = 20 * TICKS_PER_SECOND;
+    siege.count = 240;
+    siege.intervalTicks = TICKS_PER_SECOND;
+    siege.burst = 8;
+    siege.mix = {{EnemyKind::Goblin, 1}, {EnemyKind::Orc, 1}};
+    siege.lanes = {SpawnLane::Top, SpawnLane::Bottom, SpawnLane::Left, SpawnLane::Right};
+    const int placements[][2] = {{12, 9}, {5, 9}, {20, 11}, {12, 12}};
+
+    int64_t ticks = 0;
+    int lostAt = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        auto level = std::make_unique<Level>(nullptr, 1, Random::DEFAULT_SEED);
+        level->loadDefaultMap();
+        level->setWaves({siege});
+        for (const auto& p : placements) level->placeTower(p[0], p[1]);
+        state.resumeTiming();
+
+        while (!level->isGameOver()) {
+            level->update();
+            ticks++;
+        }
+        lostAt = level->isGameWon() ? 0 : level->getFrame();
+
+        state.pauseTiming();
+        level.reset();
+        state.resumeTiming();
+    }
+    if (lostAt == 0) state.skipWithError("the towers held; the siege no longer tests tower losses");
+    state.setItemsProcessed(ticks);
+    state.setLabel("lost at tick " + std::to_string(lostAt));
+}
+BENCHMARK(BM_LevelSiege);
+
+// --- Snapshots ----------------------------------------------------------------
+
+// Mid-game level: 16 mixed towers, range(0) enemies, a second of combat so effects and pools are live
+std::unique_ptr<Level> makeMidGameLevel(size_t enemyCount) {
+    auto level = std::make_unique<Level>(nullptr, 1, Random::DEFAULT_SEED);
+    level->loadDefaultMap();
+    auto towers = makeTowers(16);
+    for (size_t i = 0; i < towers.size(); ++i) {
+        static const TowerType types[] = {TowerType::Basic, TowerType::Ice, TowerType::Fire};
+        level->addTower(TowerFactory::createTower(types[i % 3], towers[i]->getPos(), nullptr));
+    }
+    for (auto& e : makeEnemies(enemyCount, 4)) level->spawnEnemy(std::move(e));
+    for (int i = 0; i < 40; ++i) level->update();
+    return level;
+}
+
+void BM_LevelSnapshotSave(bench::State& state) {
+    auto level = makeMidGameLevel(static_cast<size_t>(state.range(0)));
+    LevelSnapshot snapshot;
+    while (state.keepRunning()) {
+        level->saveSnapshot(snapshot);
+        bench::doNotOptimize(snapshot.size());
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setLabel(std::to_string(snapshot.size()) + " bytes");
+}
+BENCHMARK(BM_LevelSnapshotSave)->Arg(64)->Arg(1024);
+
+// Rewind: restore into the level the snapshot came from, reusing its objects
+void BM_LevelSnapshotRestore(bench::State& state) {
+    auto level = makeMidGameLevel(static_cast<size_t>(state.range(0)));
+    LevelSnapshot snapshot;
+    level->saveSnapshot(snapshot);
+    while (state.keepRunning()) {
+        level->restoreSnapshot(snapshot);
+        bench::doNotOptimize(level->getEnemyCount());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LevelSnapshotRestore)->Arg(64)->Arg(1024);
+
+// --- Rendering (software renderer) ------------------------------------------
+
+// range(0): 0 = cached chunks, 1 = re-bake every frame (the old per-tile cost)
+// range(1): map size in tiles (square); 0 = the default 25x20. The camera
+// shows 800x600 either way, so a big map should cost the same as a small one.
+void BM_MapDrawMap(bench::State& state) {
+    SDL_Surface* surface = SDL_CreateSurface(static_cast<int>(WORLD_W), static_cast<int>(WORLD_H),
+                                             SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer* ren = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!ren) {
+        state.skipWithError(std::string("software renderer unavailable: ") + SDL_GetError());
+        while (state.keepRunning()) {}
+        if (surface) SDL_DestroySurface(surface);
+        return;
+    }
+
+    {
+        std::unique_ptr<Map> map;
+        try {
+            map = std::make_unique<Map>(ren);
+        } catch (const GameException& e) {
+            state.skipWithError(e.what());
+        }
+        Camera camera(800.0f, 600.0f);
+        if (map) {
+            // Grass with a path across the middle (row 10 by default)
+            int side = static_cast<int>(state.range(1));
+            int rows = side > 0 ? side : Map::DEFAULT_ROWS;
+            int cols = side > 0 ? side : Map::DEFAULT_COLS;
+            Grid2D<int> tiles(rows, cols, 0);
+            for (int c = 0; c < cols; ++c) tiles.set(rows / 2, c, 1);
+            map->LoadMap(tiles);
+            camera.setWorldSize(static_cast<float>(map->getPixelWidth()), static_cast<float>(map->getPixelHeight()));
+            camera.pan(map->getPixelWidth() / 2.0f, map->getPixelHeight() / 2.0f);
+        }
+
+        const bool rebake = state.range(0) != 0;
+        while (state.keepRunning()) {
+            if (rebake) map->invalidate();
+            map->DrawMap(camera);
+        }
+    }
+    TextureManager::Clear();
+    SDL_DestroyRenderer(ren);
+    SDL_DestroySurface(surface);
+}
+BENCHMARK(BM_MapDrawMap)->Args({0, 0})->Args({1, 0})->Args({0, 512})->Args({1, 512});
+
+}
+
+int main(int argc, char* argv[]) {
+    // Keep gameplay messages out of the measurements
+    Logger::getInstance().setMinLevel(LogLevel::Warn);
+    bench::addCustomContext("simd", EnemyMotion::simdName());
+    return bench::runAll(argc, argv);
+}
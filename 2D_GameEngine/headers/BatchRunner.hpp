@@ -0,0 +1,74 @@
+#ifndef BatchRunner_hpp
+#define BatchRunner_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Grid2D.hpp"
+#include "Random.hpp"
+#include "TowerFactory.h"
+#include "WaveSchedule.hpp"
+
+class Logger;
+class ThreadPool;
+
+/**
+ * @brief What every run of a batch shares: the level the layouts are tried on.
+ */
+struct BatchScenario {
+    uint64_t seed = Random::DEFAULT_SEED;
+    Grid2D<int> tiles;          // empty: Level::loadDefaultMap()
+    std::vector<WaveDef> waves; // empty: the built-in wave
+    int maxTicks = 0;           // 0: until the level ends
+    Logger* logger = nullptr;   // shared by every run; null logs nothing
+};
+
+/**
+ * @brief How one tower layout did.
+ */
+struct BatchResult {
+    size_t layout = 0;       // index into the layouts given to BatchRunner::run()
+    int ticks = 0;           // ticks simulated
+    int survivedTicks = 0;   // until the last tower fell, or all of them if one stands
+    size_t towersPlaced = 0; // the level may refuse some (Level::MAX_TOWERS, off the map)
+    size_t towersLeft = 0;
+    int64_t damageDealt = 0;
+    bool won = false;
+    double ticksPerSecond = 0.0; // this run's simulation speed, on its worker
+};
+
+/**
+ * @brief Plays one scenario with many tower layouts, one headless Level per
+ * layout, spread over a ThreadPool.
+ *
+ * Levels share nothing, and a run depends only on the scenario and its
+ * layout, so the results (timings aside) are the same for any thread count.
+ */
+class BatchRunner {
+public:
+    explicit BatchRunner(ThreadPool& pool) : pool(pool) {}
+
+    /**
+     * @brief Run every layout; results come back in layout order.
+     * Rethrows the first GameException a run threw.
+     */
+    std::vector<BatchResult> run(const BatchScenario& scenario,
+                                 const std::vector<std::vector<TowerPlacement>>& layouts);
+
+    /**
+     * @brief One run on the calling thread.
+     */
+    static BatchResult runOne(const BatchScenario& scenario, const std::vector<TowerPlacement>& layout);
+
+    /**
+     * @brief count layouts of up to maxTowers towers each, on distinct grass
+     * tiles picked with rng, for a random placement search.
+     */
+    static std::vector<std::vector<TowerPlacement>> randomLayouts(const Grid2D<int>& tiles, size_t count,
+                                                                  int maxTowers, Random& rng);
+
+private:
+    ThreadPool& pool;
+};
+
+#endif /* BatchRunner_hpp */
@@ -0,0 +1,167 @@
+#ifndef ByteStream_hpp
+#define ByteStream_hpp
+
+#include <vector>
+#include <string>
+#include <bit>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include "GameObject.h"
+
+/**
+ * @brief Little-endian binary encoder appending to a byte buffer.
+ *
+ * Unsigned counts use LEB128 varints, signed values are zigzag-encoded
+ * first, and floats are written as their exact bits so a round trip is
+ * lossless. Values are stored through a cursor into the buffer, which
+ * grows in steps and is trimmed to the written size when the writer goes
+ * away; a caller that reuses one buffer keeps its capacity between writes.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out) : out(out), pos(out.size()) {}
+    ~ByteWriter() { out.resize(pos); }
+
+    ByteWriter(const ByteWriter&) = delete;
+    ByteWriter& operator=(const ByteWriter&) = delete;
+
+    // Bytes written so far (the buffer may be longer until the writer is destroyed)
+    size_t size() const { return pos; }
+
+    void byte(uint8_t v) {
+        reserve(1);
+        out[pos++] = v;
+    }
+
+    void bytes(const void* data, size_t size) {
+        if (size == 0) return;
+        reserve(size);
+        std::memcpy(out.data() + pos, data, size);
+        pos += size;
+    }
+
+    void varint(uint64_t v) {
+        reserve(10);
+        uint8_t* p = out.data() + pos;
+        uint8_t* start = p;
+        while (v >= 0x80) {
+            *p++ = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        *p++ = static_cast<uint8_t>(v);
+        pos += static_cast<size_t>(p - start);
+    }
+
+    void sint(int32_t v) { varint((static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31)); }
+
+    void boolean(bool v) { byte(v ? 1 : 0); }
+
+    void u64(uint64_t v) { fixed(v); }
+    void f32(float v) { fixed(std::bit_cast<uint32_t>(v)); }
+
+    void str(const std::string& s) {
+        varint(s.size());
+        bytes(s.data(), s.size());
+    }
+
+private:
+    void reserve(size_t n) {
+        if (out.size() - pos < n) out.resize(std::max(out.size() * 2, pos + n + 256));
+    }
+
+    template <typename U>
+    void fixed(U v) {
+        if constexpr (std::endian::native != std::endian::little) {
+            U swapped = 0;
+            for (size_t i = 0; i < sizeof(U); i++) swapped = static_cast<U>((swapped << 8) | ((v >> (8 * i)) & 0xff));
+            v = swapped;
+        }
+        bytes(&v, sizeof(v));
+    }
+
+    std::vector<uint8_t>& out;
+    size_t pos;
+};
+
+/**
+ * @brief Decoder for ByteWriter's encoding; throws ResourceError naming
+ * the source when the data runs out or is malformed.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size, const char* sourceName)
+        : pos(data), end(data + size), sourceName(sourceName) {}
+
+    [[noreturn]] void fail(const std::string& why) const { throw ResourceError(std::string(sourceName) + ": " + why); }
+
+    bool atEnd() const { return pos == end; }
+
+    uint8_t byte() {
+        if (pos == end) fail("unexpected end of data");
+        return *pos++;
+    }
+
+    void bytes(void* data, size_t size) {
+        if (static_cast<size_t>(end - pos) < size) fail("unexpected end of data");
+        std::copy(pos, pos + size, static_cast<uint8_t*>(data));
+        pos += size;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        fail("malformed varint");
+    }
+
+    /**
+     * @brief A varint element count, rejected above limit so corrupt data can't ask for gigabytes.
+     */
+    size_t count(uint64_t limit, const char* what) {
+        uint64_t n = varint();
+        if (n > limit) fail(std::string("too many ") + what);
+        return static_cast<size_t>(n);
+    }
+
+    int32_t sint() {
+        uint32_t v = static_cast<uint32_t>(varint());
+        return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+    }
+
+    bool boolean() { return byte() != 0; }
+
+    uint64_t u64() { return fixed<uint64_t>(); }
+    float f32() { return std::bit_cast<float>(fixed<uint32_t>()); }
+
+    void str(std::string& s) {
+        uint64_t n = varint(); // the length's own bytes come off what is left
+        if (n > static_cast<uint64_t>(end - pos)) fail("unexpected end of data");
+        s.assign(reinterpret_cast<const char*>(pos), n);
+        pos += n;
+    }
+
+private:
+    template <typename U>
+    U fixed() {
+        if (static_cast<size_t>(end - pos) < sizeof(U)) fail("unexpected end of data");
+        U v = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(&v, pos, sizeof(U));
+        } else {
+            for (size_t i = 0; i < sizeof(U); i++) v |= static_cast<U>(static_cast<U>(pos[i]) << (8 * i));
+        }
+        pos += sizeof(U);
+        return v;
+    }
+
+    const uint8_t* pos;
+    const uint8_t* end;
+    const char* sourceName;
+};
+
+#endif /* ByteStream_hpp */
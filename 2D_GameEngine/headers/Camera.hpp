@@ -0,0 +1,75 @@
+#ifndef Camera_hpp
+#define Camera_hpp
+
+#include <SDL3/SDL.h>
+
+/**
+ * @brief The part of the world shown on screen: a position, a zoom and the
+ * viewport size.
+ *
+ * screen = (world - position) * zoom. The view is kept inside the world
+ * where it fits; a world smaller than the view is pinned to the top-left
+ * corner, so the default map renders exactly as it always has.
+ */
+class Camera {
+public:
+    static constexpr float MIN_ZOOM = 0.25f;
+    static constexpr float MAX_ZOOM = 4.0f;
+
+    Camera(float viewWidth = 800.0f, float viewHeight = 600.0f);
+
+    void setViewport(float width, float height);
+    void setWorldSize(float width, float height);
+
+    /**
+     * @brief Move the view by a distance in screen pixels.
+     */
+    void pan(float dx, float dy);
+
+    /**
+     * @brief Multiply the zoom, keeping the world point under (screenX, screenY) fixed.
+     */
+    void zoomBy(float factor, float screenX, float screenY);
+
+    /**
+     * @brief Pan just enough to bring a world rect into view.
+     */
+    void ensureVisible(const SDL_FRect& world);
+
+    /**
+     * @brief Visible world rectangle.
+     */
+    SDL_FRect getView() const { return {x, y, viewW / zoom, viewH / zoom}; }
+
+    bool isVisible(const SDL_FRect& world) const {
+        return world.x < x + viewW / zoom && world.x + world.w > x &&
+               world.y < y + viewH / zoom && world.y + world.h > y;
+    }
+
+    SDL_FRect toScreen(const SDL_FRect& world) const {
+        return {(world.x - x) * zoom, (world.y - y) * zoom, world.w * zoom, world.h * zoom};
+    }
+
+    SDL_FPoint toWorld(float screenX, float screenY) const {
+        return {screenX / zoom + x, screenY / zoom + y};
+    }
+
+    float getX() const { return x; }
+    float getY() const { return y; }
+    float getZoom() const { return zoom; }
+    float getViewportWidth() const { return viewW; }
+    float getViewportHeight() const { return viewH; }
+
+private:
+    void clamp();
+
+    float x = 0.0f;
+    float y = 0.0f;
+    float zoom = 1.0f;
+    float viewW;
+    float viewH;
+    float worldW = 0.0f;
+    float worldH = 0.0f;
+};
+
+#endif /* Camera_hpp */
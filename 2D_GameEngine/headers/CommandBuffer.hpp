@@ -0,0 +1,66 @@
+#ifndef CommandBuffer_hpp
+#define CommandBuffer_hpp
+
+#include <vector>
+#include <memory>
+#include "GameObject.h"
+#include "StatusEffects.hpp"
+
+/**
+ * @brief Structural changes to a Level, recorded during a phase of
+ * Level::update() and applied together at the next sync point.
+ *
+ * Between sync points the enemy and tower lists don't change: nothing is
+ * appended (so no reallocation) and nothing is freed, so Enemy* / Tower*
+ * handles taken during a phase stay valid and the lists can be read from
+ * several threads. Whoever deals damage records the kill; destroys name
+ * the entity's slot, so removing them never inspects the survivors.
+ *
+ * At a sync point the commands are applied as: effects, destroys (towers,
+ * then enemies), spawns (enemies, then towers), each in recorded order.
+ */
+class CommandBuffer {
+public:
+    void spawn(std::unique_ptr<Enemy> enemy) { enemySpawns.push_back(std::move(enemy)); }
+    void spawn(std::unique_ptr<Tower> tower) { towerSpawns.push_back(std::move(tower)); }
+
+    // The entity must be in a Level (have a slot); recording it twice is harmless
+    void destroy(const Enemy& enemy) { enemyDestroys.push_back(enemy.getSlot()); }
+    void destroy(const Tower& tower) { towerDestroys.push_back(tower.getSlot()); }
+
+    void addSlow(Enemy& target, int ticks, float factor) { effects.push_back({EffectType::Slow, &target, ticks, factor, 0}); }
+    void addBurn(Enemy& target, int ticks, int damage) { effects.push_back({EffectType::Burn, &target, ticks, 0.0f, damage}); }
+
+    bool empty() const {
+        return enemySpawns.empty() && towerSpawns.empty() && enemyDestroys.empty() && towerDestroys.empty() &&
+               effects.empty();
+    }
+
+    // Drop everything recorded (spawned objects are freed)
+    void clear() {
+        enemySpawns.clear();
+        towerSpawns.clear();
+        enemyDestroys.clear();
+        towerDestroys.clear();
+        effects.clear();
+    }
+
+private:
+    friend class Level;
+
+    struct EffectCommand {
+        EffectType type;
+        Enemy* target;
+        int ticks;
+        float factor; // Slow
+        int damage;   // Burn
+    };
+
+    std::vector<std::unique_ptr<Enemy>> enemySpawns;
+    std::vector<std::unique_ptr<Tower>> towerSpawns;
+    std::vector<int> enemyDestroys; // slots
+    std::vector<int> towerDestroys;
+    std::vector<EffectCommand> effects;
+};
+
+#endif /* CommandBuffer_hpp */
@@ -0,0 +1,53 @@
+#ifndef EnemyMotion_hpp
+#define EnemyMotion_hpp
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class Enemy;
+
+/**
+ * @brief Structure-of-arrays store for the batched enemy movement kernel.
+ *
+ * Level copies the active enemies' position, speed and target into
+ * contiguous arrays, moves them all in one pass and writes the positions
+ * back. The kernel uses AVX2 or SSE when the build enables them and a
+ * scalar loop otherwise; every path performs the same IEEE operations in
+ * the same order as Enemy::move(), so results are bit-identical.
+ *
+ * The arrays are rebuilt from the Enemy objects every tick, because the
+ * objects stay the owners of position for collision, the grids, rendering
+ * and snapshots. That gather and scatter, not the kernel, is the cost at
+ * large counts (see BM_EnemyMotionKernel against BM_EnemyMotionStep).
+ */
+class EnemyMotion {
+public:
+    void load(const std::vector<std::unique_ptr<Enemy>>& enemies);
+    void step();
+    void store() const;
+
+    size_t size() const { return x.size(); }
+
+    // Kernels over raw arrays, [begin, end)
+    static void stepScalar(float* px, float* py, const float* speed,
+                           const float* tx, const float* ty, size_t begin, size_t end);
+    static void stepSimd(float* px, float* py, const float* speed,
+                         const float* tx, const float* ty, size_t count);
+
+    /**
+     * @brief Name of the instruction set the SIMD kernel was compiled for.
+     */
+    static const char* simdName();
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> speed;
+    std::vector<float> targetX;
+    std::vector<float> targetY;
+
+private:
+    std::vector<Enemy*> owners; // Enemy each lane was loaded from
+};
+
+#endif /* EnemyMotion_hpp */
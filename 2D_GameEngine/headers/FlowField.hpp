@@ -0,0 +1,90 @@
+#ifndef FlowField_hpp
+#define FlowField_hpp
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "Grid2D.hpp"
+
+class Map;
+
+/**
+ * @brief Dijkstra distance field over the map's tiles, shared by all enemies.
+ *
+ * Every tile stores its travel cost to the nearest goal tile, where the
+ * cost of entering a tile is the time it takes to cross it (slow terrain
+ * costs more). An enemy looks up its tile and heads for the neighbour
+ * with the lowest distance, so following the field is O(1) per enemy per
+ * tick no matter how many enemies there are.
+ *
+ * Adding a goal only ever shortens distances, so addGoal() relaxes
+ * outward from the new goal alone. Removing goals or changing tiles needs
+ * rebuild(), which also adopts the map's size. Tile indices are row-major
+ * (row * cols + col).
+ */
+class FlowField {
+public:
+    static constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    FlowField(int cols, int rows, int tileSize);
+
+    /**
+     * @brief Recompute every distance from scratch for these goal tiles (sized to the map).
+     */
+    void rebuild(const Map& map, const std::vector<int>& goalTiles);
+
+    /**
+     * @brief Add one goal and update only the tiles it gets closer to.
+     */
+    void addGoal(int tile);
+
+    /**
+     * @brief Tile index under a pixel position, clamped to the grid.
+     */
+    int tileAt(float x, float y) const;
+
+    /**
+     * @brief Neighbour one step closer to a goal (the tile itself at a goal or when unreachable).
+     */
+    int nextTile(int tile) const;
+
+    uint32_t getDistance(int tile) const { return dist[tile]; }
+    bool isGoal(int tile) const { return dist[tile] == 0; }
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+
+    int getCol(int tile) const { return tile % cols; }
+    int getRow(int tile) const { return tile / cols; }
+    int toTile(int row, int col) const { return row * cols + col; }
+
+    // Map revision the costs were taken from (see Map::getRevision)
+    unsigned getMapRevision() const { return mapRevision; }
+
+    // Stats
+    int getRebuildCount() const { return rebuilds; }
+    int getIncrementalCount() const { return incrementals; }
+
+private:
+    struct Node {
+        uint32_t dist;
+        int tile;
+        bool operator>(const Node& other) const { return dist > other.dist; }
+    };
+
+    void propagate();
+    void push(uint32_t d, int tile);
+
+    int cols;
+    int rows;
+    int tileSize;
+    Grid2D<uint16_t> cost; // cost of entering each tile; 0 = impassable
+    Grid2D<uint32_t> dist;
+    std::vector<Node> heap;     // min-heap, reused between updates
+
+    unsigned mapRevision = 0;
+    int rebuilds = 0;
+    int incrementals = 0;
+};
+
+#endif /* FlowField_hpp */
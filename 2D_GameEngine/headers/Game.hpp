@@ -3,7 +3,12 @@
 
 #include "SDL3/SDL.h"
 #include <iostream>
+#include <string>
 #include <SDL3_image/SDL_image.h>
+#include "TextureManager.h"
+#include "LevelSnapshot.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
 
 /**
  * @brief Main Game class managing the game loop and state.
@@ -22,12 +27,26 @@ public:
 
     void handleEvents();
     void update();
-    void render();
+    void render(float alpha = 1.0f); // alpha: interpolation between the last two ticks
     void clean();
 
     bool running() {
         return isRunning;
     }
+    
+    // Fast-forward: the main loop runs ticks as fast as it can instead of in real time
+    bool isFastForward() const { return fastForward; }
+    
+    /**
+     * @brief Record the level's inputs; the replay is written to path by clean().
+     */
+    void startRecording(const char* path);
+    
+    /**
+     * @brief Replay a recorded session instead of taking level input; skips the menu.
+     * @return false (leaving the normal game) if the replay can't be loaded.
+     */
+    bool startReplay(const char* path);
 
     friend std::ostream& operator<<(std::ostream& os, const Game& game);
 
@@ -38,20 +57,35 @@ public:
     };
 
 private:
+    /**
+     * @brief Start a profiler trace, or stop it and export trace + stats files.
+     */
+    void toggleTraceCapture();
+    
+    /**
+     * @brief F5 keeps a checkpoint of the level, F9 rewinds to it.
+     */
+    void quickSaveOrLoad(bool load);
+
     bool isRunning;
     SDL_Window *window;
     SDL_Renderer *renderer;
     
     GameState gameState;
+    bool fastForward = false;
+    bool showProfiler = false; // F3 overlay (profiler builds only)
+    std::string recordPath;    // where clean() saves the recorded inputs
+    LevelSnapshot checkpoint;  // F5 / F9
     
     // Menu Assets
-    SDL_Texture* menuBg;
-    SDL_Texture* btnStart;
-    SDL_Texture* btnQuit;
-    SDL_Texture* btnManual;
+    TextureHandle menuBg;
+    TextureHandle btnStart;
+    TextureHandle btnQuit;
+    TextureHandle btnManual;
     SDL_FRect startRect, quitRect, manualRect;
     
     class Level* level;
+    std::unique_ptr<ThreadPool> workers; // the level's AI query passes on big waves
 };
 
 #endif /* Game_hpp */
@@ -10,10 +10,16 @@
 #include <memory>
 #include <algorithm>
 #include <exception>
+#include <atomic>
 #include "IDamageable.h"
-
-// Forward check
-class Effect;
+#include "TextureManager.h"
+#include "SpriteBatch.hpp"
+#include "StatusEffects.hpp"
+#include "Stat.hpp"
+
+class ByteWriter;
+class ByteReader;
+class CommandBuffer;
 class GameException : public std::exception {
 protected:
     std::string message;
@@ -88,13 +94,20 @@ public:
 
     // Pure Virtuals
     virtual void update() = 0;
-    virtual void render() = 0;
+    virtual void render(SpriteBatch& batch, float alpha) = 0;
     
     /**
      * @brief Handle collision with another object.
      * @param other The object collided with.
      */
     virtual void onCollision(GameObject& other);
+    
+    /**
+     * @brief Write / read everything the simulation depends on (Level snapshots).
+     * The renderer and texture are not state; loadState keeps the object's own.
+     */
+    virtual void saveState(ByteWriter& out) const;
+    virtual void loadState(ByteReader& in);
 
     // NVI for printing
     friend std::ostream& operator<<(std::ostream& os, const GameObject& obj);
@@ -104,9 +117,25 @@ public:
     float getY() const { return yPos; }
     Point2D getPos() const { return Point2D(xPos, yPos); }
     void setPos(float x, float y) { xPos = x; yPos = y; }
+    
+    /**
+     * @brief Remember the current position as the start of the next tick.
+     */
+    void storePreviousPos() { prevX = xPos; prevY = yPos; }
+    
+    /**
+     * @brief Position blended between the previous and current tick (alpha in [0, 1]).
+     */
+    Point2D getRenderPos(float alpha) const {
+        return Point2D(prevX + (xPos - prevX) * alpha, prevY + (yPos - prevY) * alpha);
+    }
     bool isActive() const { return active; }
     void setActive(bool a) { active = a; }
     
+    // Index in the owning Level's enemy/tower list, kept by the Level (-1: not in one)
+    int getSlot() const { return slot; }
+    void setSlot(int index) { slot = index; }
+    
     // Static member for teacher requirement
     static int getCount(); 
     
@@ -123,18 +152,27 @@ public:
 protected:
     virtual void print(std::ostream& os) const; // For NVI
 
+    /**
+     * @brief Queue objTexture at destRect (shifted to the interpolated position), tinted by this object's color.
+     */
+    void drawTexture(SpriteBatch& batch, SpriteBatch::Layer layer, float alpha) const;
+
     float xPos;
     float yPos;
+    float prevX; // position at the start of the current tick, for render interpolation
+    float prevY;
     int width;
     int height;
     bool active;
     
     SDL_Renderer* renderer; 
     std::string texturePath;
-    SDL_Texture* objTexture;
+    TextureHandle objTexture; // Shared via TextureManager cache
+    SDL_Color tint{255, 255, 255, 255}; // Per-object color mod (texture is shared)
     SDL_FRect srcRect{}, destRect{};
+    int slot = -1; // not copied: a copy isn't in the list
     
-    static int objectCount;
+    static std::atomic<int> objectCount; // levels may live on several threads
 };
 
 // Enemy class
@@ -146,10 +184,11 @@ private:
     std::string name;  
     int health;
     int maxHealth;
-    float speed;
+    Stat speed; // base comes from the terrain; slows are modifiers on top
     
-    // Effects List
-    std::vector<std::unique_ptr<Effect>> effects;
+    // Active status effects per EffectType; the records live in the level's StatusEffects
+    uint16_t effectCounts[static_cast<size_t>(EffectType::Count)] = {};
+    friend class StatusEffects;
 
     Point2D targetPos;
 
@@ -161,8 +200,20 @@ public:
     std::unique_ptr<GameObject> clone() const override;
 
     void update() override;
-    void render() override;
+    void render(SpriteBatch& batch, float alpha) override;
     void onClick() override; // TEMA 2 Specific
+    void saveState(ByteWriter& out) const override;
+    void loadState(ByteReader& in) override; // drops speed modifiers and effect counts; effects re-add them
+    
+    /**
+     * @brief Step one tick toward targetPos (reference for EnemyMotion's batched kernel).
+     */
+    void move();
+    
+    /**
+     * @brief Per-tick work after movement: sprite rects.
+     */
+    void updateAfterMove();
     
     // IDamageable
     void takeDamage(int amount) override;
@@ -170,12 +221,12 @@ public:
     int getHealth() const override { return health; }
 
     void setTarget(float x, float y);
-    void setSpeed(float s) { speed = s; }
-    float getSpeed() const { return speed; }
+    const Point2D& getTarget() const { return targetPos; }
+    void setBaseSpeed(float s) { speed.setBase(s); }
+    float getSpeed() const { return speed.get(); } // effective, cached
+    Stat& getSpeedStat() { return speed; }
     
-    // Effect Management
-    void addEffect(std::unique_ptr<Effect> effect);
-    void updateEffects();
+    int getEffectCount(EffectType type) const { return effectCounts[static_cast<size_t>(type)]; }
     
     // Static Factory
     static std::unique_ptr<Enemy> createGoblin(SDL_Renderer* ren, int x, int y);
@@ -205,14 +256,17 @@ public:
     std::unique_ptr<GameObject> clone() const override;
 
     void update() override;
-    void render() override;
+    void render(SpriteBatch& batch, float alpha) override;
+    void saveState(ByteWriter& out) const override;
+    void loadState(ByteReader& in) override;
     
     // IDamageable
     void takeDamage(int amount) override;
     bool isAlive() const override { return health > 0; }
     int getHealth() const override { return health; }
     
-    virtual void attack(Enemy& enemy);
+    // On-hit effects, and the kill if the hit is fatal, are recorded in commands
+    virtual void attack(Enemy& enemy, CommandBuffer& commands);
     void upgrade();
     bool canAttack(const Enemy& enemy) const;
     int getDamage() const { return damage; }
@@ -239,9 +293,16 @@ public:
     Projectile(Point2D start, Point2D target, float speed, SDL_Renderer* ren, SDL_Color col);
     
     std::unique_ptr<GameObject> clone() const override;
+    
+    /**
+     * @brief Re-arm a pooled projectile for a new shot.
+     */
+    void launch(Point2D start, Point2D targetPos, SDL_Color col);
 
     void update() override;
-    void render() override;
+    void render(SpriteBatch& batch, float alpha) override;
+    void saveState(ByteWriter& out) const override;
+    void loadState(ByteReader& in) override;
     
 protected:
     void print(std::ostream& os) const override;
@@ -257,8 +318,15 @@ private:
 public:
     Explosion(Point2D pos, SDL_Renderer* ren);
     std::unique_ptr<GameObject> clone() const override;
+    
+    /**
+     * @brief Re-arm a pooled explosion at a new position.
+     */
+    void spawn(Point2D pos);
     void update() override;
-    void render() override;
+    void render(SpriteBatch& batch, float alpha) override;
+    void saveState(ByteWriter& out) const override;
+    void loadState(ByteReader& in) override;
     
 protected:
     void print(std::ostream& os) const override;
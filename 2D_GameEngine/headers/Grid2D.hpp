@@ -0,0 +1,79 @@
+#ifndef Grid2D_hpp
+#define Grid2D_hpp
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+
+/**
+ * @brief 2D grid sized at runtime, stored in one contiguous row-major
+ * buffer (index = row * cols + col), so full sweeps are linear and callers
+ * can use linear indices directly.
+ *
+ * get()/set() are bounds-checked (out of range reads give T(), writes
+ * are ignored). at() is the unchecked fast path for loops that already
+ * know their coordinates are valid; it only asserts in debug builds.
+ *
+ * @tparam T Type of data stored (int, float, etc.)
+ */
+template <typename T>
+class Grid2D {
+public:
+    Grid2D() = default;
+
+    Grid2D(int rows, int cols, T value = T()) {
+        resize(rows, cols, value);
+    }
+
+    /**
+     * @brief Change the dimensions; every cell is reset to value.
+     */
+    void resize(int newRows, int newCols, T value = T()) {
+        rows = std::max(newRows, 0);
+        cols = std::max(newCols, 0);
+        cells.assign(static_cast<size_t>(rows) * cols, value);
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    bool empty() const { return rows == 0 || cols == 0; }
+
+    bool inBounds(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+
+    // Bounds-checked access
+    T get(int r, int c) const { return inBounds(r, c) ? cells[index(r, c)] : T(); }
+
+    void set(int r, int c, T val) {
+        if (inBounds(r, c)) cells[index(r, c)] = val;
+    }
+
+    // Unchecked access
+    T& at(int r, int c) {
+        assert(inBounds(r, c));
+        return cells[index(r, c)];
+    }
+
+    const T& at(int r, int c) const {
+        assert(inBounds(r, c));
+        return cells[index(r, c)];
+    }
+
+    size_t index(int r, int c) const { return static_cast<size_t>(r) * cols + c; }
+
+    // Linear access to the raw buffer
+    T& operator[](size_t i) { return cells[i]; }
+    const T& operator[](size_t i) const { return cells[i]; }
+    T* data() { return cells.data(); }
+    const T* data() const { return cells.data(); }
+    size_t bufferSize() const { return cells.size(); }
+
+    void fill(T val) { std::fill(cells.begin(), cells.end(), val); }
+
+private:
+    std::vector<T> cells;
+    int rows = 0;
+    int cols = 0;
+};
+
+#endif /* Grid2D_hpp */
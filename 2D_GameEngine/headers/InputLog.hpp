@@ -0,0 +1,117 @@
+#ifndef InputLog_hpp
+#define InputLog_hpp
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include "Grid2D.hpp"
+#include "WaveSchedule.hpp"
+
+/**
+ * @brief Player inputs that reach the simulation.
+ */
+enum class InputType : uint8_t {
+    Key,         // Level::handleInput
+    Click,       // Level::handleMouseClick, already converted to world coordinates
+    Wheel,       // Level::handleMouseWheel
+    SelectTower, // Level::selectTowerType
+    PlaceTower,  // Level::placeTower
+    Count
+};
+
+/**
+ * @brief One recorded input, stamped with the tick it arrived at.
+ */
+struct InputEvent {
+    int tick = 0; // Level::getFrame() when it arrived; replayed before the next update()
+    InputType type = InputType::Key;
+    int32_t a = 0; // Key: keycode, SelectTower: TowerType, PlaceTower: column
+    int32_t b = 0; // PlaceTower: row
+    float x = 0.0f, y = 0.0f; // Click: world point, Wheel: pointer (screen)
+    float wheel = 0.0f;       // Wheel: scroll amount
+};
+
+/**
+ * @brief Everything needed to re-run a level: seed, map, waves and the
+ * player's inputs, in tick order.
+ *
+ * A Level is deterministic for a given seed, map, wave list and input
+ * sequence, so that is all a recording holds; replaying it reproduces the
+ * session tick for tick, with or without a window.
+ *
+ * Binary format (little-endian; "varint" is LEB128, signed values are
+ * zigzag-encoded first):
+ *
+ *   "TDRP"  varint version  u64 seed  varint endTick
+ *   varint cols  varint rows  rows*cols x varint tile
+ *   varint waveCount, per wave: start count interval burst,
+ *       varint mixCount x (u8 kind, weight), varint laneCount x u8 lane
+ *   varint eventCount, per event: varint tick delta  u8 type  payload
+ *
+ * Payloads: Key varint keycode; Click f32 x, f32 y; Wheel f32 x, f32 y,
+ * f32 wheel; SelectTower u8 type; PlaceTower col, row. A typical input
+ * takes 3-6 bytes.
+ */
+class InputLog {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    InputLog() = default;
+    InputLog(uint64_t seed, const Grid2D<int>& tiles, const std::vector<WaveDef>& waves)
+        : seed(seed), tiles(tiles), waves(waves) {}
+
+    /**
+     * @brief Append an input; ticks must not go backwards.
+     */
+    void record(const InputEvent& event);
+
+    /**
+     * @brief Call apply(event) for every input due at or before tick, in order.
+     */
+    template <typename Fn>
+    void consume(int tick, Fn&& apply) {
+        while (cursor < events.size() && events[cursor].tick <= tick) {
+            apply(events[cursor++]);
+        }
+    }
+
+    void rewind() { cursor = 0; }
+
+    /**
+     * @brief Write the log; throws ResourceError if the file cannot be written.
+     */
+    void save(const char* path) const;
+    void write(std::ostream& out) const;
+
+    /**
+     * @brief Read a log; throws ResourceError if missing, truncated, corrupt or from another version.
+     */
+    static InputLog loadFile(const char* path);
+    static InputLog read(std::istream& in, const std::string& sourceName);
+
+    uint64_t getSeed() const { return seed; }
+    const Grid2D<int>& getTiles() const { return tiles; }
+    const std::vector<WaveDef>& getWaves() const { return waves; }
+    const std::vector<InputEvent>& getEvents() const { return events; }
+    size_t size() const { return events.size(); }
+    size_t remaining() const { return events.size() - cursor; }
+
+    // Last tick of the recorded session
+    int getEndTick() const { return endTick; }
+    void setEndTick(int tick) { endTick = tick; }
+
+private:
+    void encode(std::vector<uint8_t>& buffer) const;
+
+    uint64_t seed = 0;
+    Grid2D<int> tiles;
+    std::vector<WaveDef> waves;
+    std::vector<InputEvent> events;
+    int endTick = 0;
+    size_t cursor = 0;
+};
+
+#endif /* InputLog_hpp */
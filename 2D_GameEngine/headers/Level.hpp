@@ -7,13 +7,60 @@
 #include "GameObject.h"
 #include "Map.hpp"
 #include "TowerFactory.h"
+#include "SpatialGrid.hpp"
+#include "EnemyMotion.hpp"
+#include "ObjectPool.hpp"
+#include "Random.hpp"
+#include "SpriteBatch.hpp"
+#include "WaveSchedule.hpp"
+#include "FlowField.hpp"
+#include "Camera.hpp"
+#include "StatusEffects.hpp"
+#include "InputLog.hpp"
+#include "LevelSnapshot.hpp"
+#include "CommandBuffer.hpp"
+
+class Logger;
+class ThreadPool;
+
+// Simulation ticks per second of game time. Every gameplay timer and speed
+// is expressed in ticks, so this is the rate the game is tuned for.
+#define TICKS_PER_SECOND 30
 
 /**
  * @brief Manages a single game level, including map and objects.
+ *
+ * A null renderer runs the level headless: no textures are loaded and
+ * render() does nothing, but update() runs the full simulation.
+ *
+ * All randomness comes from the level's own seeded Random, and update()
+ * never reads the clock, so the same seed and the same sequence of
+ * inputs (applied at the same ticks) give a bit-identical simulation.
+ * That is what recording relies on: the player's inputs go through the
+ * public handlers below, which can log them to an InputLog, and a level
+ * started from that log replays them at their ticks.
+ *
+ * A level shares no mutable state with other levels: what it logs goes to
+ * its own logger (see setLogger()), so independent levels can be updated
+ * on different threads at the same time.
+ *
+ * Within one update(), the enemy and tower AI phases each run a read-only
+ * query pass (nearest target, flow step) over chunks of entities, on a
+ * ThreadPool if one is set, then apply the results one entity at a time
+ * in storage order. A query whose target died earlier in the apply pass is
+ * asked again, so the outcome is exactly that of a one-by-one loop, with
+ * or without threads.
+ *
+ * Spawns, kills and status effects raised during update() are recorded in
+ * a CommandBuffer and applied at sync points (after the spawn phase and at
+ * the end of the tick), so the enemy and tower lists hold still while a
+ * phase runs.
  */
 class Level {
 public:
-    Level(SDL_Renderer* ren, int wave);
+    static constexpr int MAX_TOWERS = 4; // towers the player may place per level
+
+    Level(SDL_Renderer* ren, int wave, uint64_t seed = Random::DEFAULT_SEED);
     ~Level(); // Manage map
     
     // Disable copy/move due to managed resources
@@ -23,40 +70,207 @@ public:
     // User interaction
     void placeTower(int x, int y);
     void handleInput(SDL_Keycode key);
-    void handleMouseClick(int x, int y);
-    void loadMap(int arr[20][25]);
+    void handleMouseClick(int x, int y);        // screen coordinates
+    void handleMouseWheel(float x, float y, float wheel); // zoom around the pointer
+    void loadMap(const Grid2D<int>& tiles); // Any size; grids, spawn edges and cursor follow it
+    // Grass with a horizontal path across the middle (row 10 at the default size)
+    void loadDefaultMap(int cols = Map::DEFAULT_COLS, int rows = Map::DEFAULT_ROWS);
+    
+    /**
+     * @brief Replace the spawn timeline with the waves in a file.
+     * @return false (keeping the built-in wave) if the file is missing or malformed.
+     */
+    bool loadWaves(const char* path);
+    void setWaves(const std::vector<WaveDef>& waves); // Replaces the spawn timeline
+    void selectTowerType(TowerType type);
+    
+    /**
+     * @brief Log every input from now on, along with the seed, map and waves.
+     * Call on a fresh level, after its map and waves are loaded.
+     * @return false if the level has already started.
+     */
+    bool startRecording();
+    
+    /**
+     * @brief Finish recording; the log ends at the current tick.
+     * Throws LogicError if not recording.
+     */
+    InputLog stopRecording();
+    
+    /**
+     * @brief Load the log's seed, map and waves and re-apply its inputs at
+     * their ticks from the next update(). Live input is ignored meanwhile.
+     * @return false if the level has already started.
+     */
+    bool startPlayback(InputLog log);
+    
+    /**
+     * @brief Send everything logged during this level's calls to logger;
+     * null logs nothing. Defaults to Logger::getInstance().
+     */
+    void setLogger(Logger* target) { logger = target; }
+    Logger* getLogger() const { return logger; }
+    
+    /**
+     * @brief Run the AI query passes on pool (null: on the calling thread).
+     * The pool must outlive the level or be unset first.
+     */
+    void setThreadPool(ThreadPool* workers) { pool = workers; }
+    
+    bool isRecording() const { return recording != nullptr; }
+    bool isPlayingBack() const { return playback != nullptr; }
+    
+    /**
+     * @brief Save the whole simulation state into out (its buffer is reused).
+     */
+    void saveSnapshot(LevelSnapshot& out) const;
+    
+    /**
+     * @brief Return to a saved state: a rewind on this level, or a fork on a
+     * fresh one. Throws ResourceError if the snapshot is from another version
+     * or corrupt, in which case the level is left as it was, and LogicError
+     * while recording (the replay can't go back in time).
+     */
+    void restoreSnapshot(const LevelSnapshot& snapshot);
+    
+    // Scenario hooks (benchmarks, tools): add objects directly, skipping the
+    // player's placement rules (prep phase, MAX_TOWERS, spawn timer)
+    void spawnEnemy(std::unique_ptr<Enemy> enemy);
+    void addTower(std::unique_ptr<Tower> tower);
+    
+    // Renderer lost its target textures (or the whole device): re-bake cached layers
+    void onRenderTargetsReset(bool deviceLost);
     
     void update();
-    void render();
+    void render(float alpha = 1.0f); // alpha: fraction of a tick since the last update, for interpolation
+    
+    // Simulation state
+    bool isGameOver() const { return gameOver; }
+    bool isGameWon() const { return gameWon; }
+    int getFrame() const { return gameTimerFrames; }
+    int getTowersPlaced() const { return towersPlaced; }
+    size_t getEnemyCount() const { return enemies.size(); }
+    size_t getTowerCount() const { return towers.size(); }
+    int64_t getDamageDealt() const { return damageDealt; } // health taken off enemies by towers and burns
+    uint64_t getSeed() const { return seed; }
+    const Random& getRandom() const { return rng; }
+    const Camera& getCamera() const { return camera; }
 
 private:
     void renderCursor();
+    void followCursor(); // keep the keyboard cursor on screen
+    void placeTowerAt(int col, int row);
+    void clickAt(SDL_FPoint world);
+    bool isFresh() const;
+    // Records a live input; false if it must be dropped (replay in progress)
+    bool takeInput(const InputEvent& input);
+    void applyInput(const InputEvent& input);
+    void compileWaves(const std::vector<WaveDef>& waves);
+    Point2D getMapCenter() const;
+    int flowTileOf(const GameObject& obj) const;
+    void onTowerAdded(const Tower& tower);
+    void rebuildFlowField();
+    void adopt(std::unique_ptr<Enemy> enemy); // append and give it its slot
+    void adopt(std::unique_ptr<Tower> tower);
+    void commit(); // sync point: apply and clear the recorded commands
+    template <typename Fn>
+    void forChunks(size_t count, Fn&& body); // body(begin, end), split over the pool if set
     
-    // Polymorphic container (Smart Pointers)
-    std::vector<std::unique_ptr<GameObject>> objects;
+    // Per-type storage (Smart Pointers). Each object lives at a fixed address
+    // and knows its slot here; the lists only change at a commit(), so
+    // Enemy* / Tower* handles stay valid until the next sync point.
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    std::vector<std::unique_ptr<Tower>> towers;
     
     // Helpers
-    std::vector<Enemy*> getEnemies();
-    std::vector<Tower*> getTowers();
+    const std::vector<std::unique_ptr<Enemy>>& getEnemies() const { return enemies; }
+    const std::vector<std::unique_ptr<Tower>>& getTowers() const { return towers; }
 
     int cursorX, cursorY; 
     int towersPlaced;
-    // MAX_TOWERS moved to cpp implementation to force update
     
     int gameTimerFrames; 
     bool gameOver;
     bool gameWon;
+    int64_t damageDealt = 0;
     
     // Level specific
     SDL_Renderer* renderer;
+    Logger* logger;
     Map* map;
     int currentWave;
     int frameCount;
-    int spawnTimer;
+    
+    // Deterministic randomness (spawn side, position, enemy type)
+    uint64_t seed;
+    Random rng;
+    
+    // Every spawn of the level, precomputed and sorted by tick
+    std::vector<WaveDef> waveDefs; // kept to recompile when the map is resized
+    WaveSchedule spawnSchedule;
+    
+    
+    // Target acquisition, rebuilt every tick
+    SpatialGrid<Enemy> enemyGrid;
+    SpatialGrid<Tower> towerGrid;
+    
+    // AI query pass results, one per enemy / tower, read by the apply passes
+    struct EnemyQuery {
+        Tower* target = nullptr;
+        int tile = 0;
+        int next = 0;
+    };
+    std::vector<EnemyQuery> enemyQueries;
+    std::vector<Enemy*> towerQueries;
+    ThreadPool* pool = nullptr;
+    
+    // Shared path to the towers (or the centre), updated only when they or the tiles change
+    FlowField flowField;
+    bool flowFieldDirty = true;
+    bool flowGoalsAreTowers = false;
+    
+    // Batched movement for all enemies
+    EnemyMotion enemyMotion;
+    
+    // Slows and burns on enemies, updated one type at a time
+    StatusEffects statusEffects;
+    
+    // Spawns, kills and effects waiting for the next sync point
+    CommandBuffer commands;
+    
+    // Short-lived visuals, recycled instead of allocated per shot
+    ObjectPool<Projectile> projectiles;
+    ObjectPool<Explosion> explosions;
+    
+    // restoreSnapshot() decodes into these and swaps them in only once the
+    // whole snapshot checked out; what they replace is reused the next time
+    struct RestoredEffect {
+        uint32_t target; // index into the restored enemies
+        int ticksLeft;
+        float factor;    // slows
+        int damage;      // burns
+    };
+    std::vector<std::unique_ptr<Enemy>> spareEnemies;
+    std::vector<std::unique_ptr<Tower>> spareTowers;
+    std::vector<RestoredEffect> restoredSlows;
+    std::vector<RestoredEffect> restoredBurns;
+    ObjectPool<Projectile> spareProjectiles;
+    ObjectPool<Explosion> spareExplosions;
+    
+    // Entity sprites and bars, submitted once per frame in render()
+    SpriteBatch batch;
+    
+    // What part of the map is on screen; only chunks/objects inside it are drawn
+    Camera camera;
     
     // UI Logic
     TowerType selectedTowerType = TowerType::Basic;
     
+    // Input recording / replay (at most one of the two is active)
+    std::unique_ptr<InputLog> recording;
+    std::unique_ptr<InputLog> playback;
+    bool applyingPlayback = false;
+    
     friend std::ostream& operator<<(std::ostream& os, const Level& level);
 };
 
@@ -0,0 +1,65 @@
+#ifndef LevelSnapshot_hpp
+#define LevelSnapshot_hpp
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+class Enemy;
+
+/**
+ * @brief The full simulation state of a Level, encoded in one byte buffer.
+ *
+ * Level::saveSnapshot() fills it; Level::restoreSnapshot() puts that
+ * level, or a fresh one forked from it, back in exactly that state, so
+ * the ticks that follow are bit-identical. Objects are written through
+ * their saveState()/loadState() overrides. Restoring decodes into a spare
+ * set of objects and pools that is swapped in once the whole buffer checks
+ * out; the replaced set becomes the spare for the next restore. A snapshot
+ * object that is reused keeps its buffer capacity, so checkpointing every
+ * few ticks (rewind) doesn't allocate after the first round trip.
+ *
+ * Binary format (ByteStream encoding):
+ *
+ *   "TDSN"  varint version  u64 seed  u64 rng state  u64 rng inc
+ *   cursor, towers placed, timer, game over/won, wave, volley timer, varint damage dealt,
+ *   selected tower
+ *   tiles (Map::writeTiles)  waves (WaveSchedule::write)  varint spawn cursor
+ *   varint enemyCount x Enemy state
+ *   varint towerCount x (u8 TowerType, Tower state)
+ *   varint slowCount x (varint enemy, ticksLeft, f32 factor)
+ *   varint burnCount x (varint enemy, ticksLeft, damage)
+ *   projectile pool  explosion pool (ObjectPool::saveState)
+ *
+ * Derived data (query grids, flow field, render caches) is rebuilt, and
+ * the camera and input recording/playback are left alone.
+ */
+class LevelSnapshot {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    /**
+     * @brief Write the snapshot to a file; throws ResourceError on failure.
+     */
+    void save(const char* path) const;
+
+    /**
+     * @brief Read a snapshot file; throws ResourceError if it can't be read.
+     * The contents are validated by Level::restoreSnapshot().
+     */
+    static LevelSnapshot loadFile(const char* path);
+
+    const std::vector<uint8_t>& getBytes() const { return bytes; }
+    size_t size() const { return bytes.size(); }
+    bool empty() const { return bytes.empty(); }
+
+private:
+    friend class Level;
+
+    std::vector<uint8_t> bytes;
+    // Scratch for saving: enemy address -> index, sorted for lookup
+    std::vector<std::pair<const Enemy*, uint32_t>> enemyIndex;
+};
+
+#endif /* LevelSnapshot_hpp */
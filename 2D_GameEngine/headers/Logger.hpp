@@ -2,10 +2,79 @@
 #define Logger_hpp
 
 #include <cstdio>
+#include <cstdint>
+#include <cstddef>
 #include <string>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <algorithm>
 
+/**
+ * @brief Severity levels, lowest first.
+ */
+enum class LogLevel : int {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * @brief Subsystems that can be filtered independently at runtime.
+ */
+enum class LogCategory : int {
+    General = 0,
+    Game,
+    Level,
+    Combat,
+    Resource,
+    Count
+};
+
+// Compile-time minimum level (numeric LogLevel). Calls below it are removed
+// entirely, arguments and formatting included. Set from CMake (LOG_MIN_LEVEL).
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1
+#endif
+
+/**
+ * @brief Asynchronous file logger.
+ *
+ * log() copies the message into a lock-free bounded ring buffer (multiple
+ * producers, one consumer) and returns; a background writer thread drains
+ * the ring in batches with one fwrite per batch and flushes according to
+ * the flush policy. Before init() (or after close()) messages go straight
+ * to stdout as before.
+ *
+ * Prefer the LOG_* macros over log(): they drop calls below LOG_MIN_LEVEL
+ * at compile time and check the runtime level/category filter before any
+ * formatting happens.
+ *
+ * The macros write to current(): getInstance() unless a Logger::Scope on
+ * this thread points them elsewhere. A Level routes everything logged
+ * during its calls to its own logger that way, so levels running side by
+ * side on worker threads can each have a logger, or none.
+ */
 class Logger {
 public:
+    enum class FlushPolicy {
+        EveryBatch, // fflush after every batch written
+        Interval,   // fflush at most once per flush interval
+        OnClose     // only flush on flush()/close()
+    };
+
+    enum class OverflowPolicy {
+        Drop,  // discard the message and count it
+        Block  // spin until the writer frees a slot (backpressure)
+    };
+
+    Logger() = default;
+    ~Logger() { close(); }
+
     // Delete copy/move
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
@@ -15,17 +84,142 @@ public:
         return instance;
     }
 
+    /**
+     * @brief Where the LOG_* macros write on this thread; null means nowhere.
+     */
+    static Logger* current() { return redirected ? redirect : &getInstance(); }
+
+    /**
+     * @brief Sends this thread's LOG_* output to another logger (or, with
+     * null, drops it) until the scope ends. Scopes nest.
+     */
+    class Scope {
+    public:
+        explicit Scope(Logger* logger) : previous(redirect), wasRedirected(redirected) {
+            redirect = logger;
+            redirected = true;
+        }
+        ~Scope() {
+            redirect = previous;
+            redirected = wasRedirected;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Logger* previous;
+        bool wasRedirected;
+    };
+
     void init(const std::string& filename);
     void init(const char* filename);
     void log(const std::string& message);
     void log(const char* message);
+    void log(const char* message, size_t length);
+
+    /**
+     * @brief printf-style formatted message, tagged with level and category.
+     *
+     * Formats into a reusable per-thread buffer; nothing is allocated.
+     * Call through the LOG_* macros so disabled levels cost nothing.
+     */
+    template <typename... Args>
+    void logf(LogLevel level, LogCategory category, const char* format, Args... args) {
+        thread_local char buffer[MAX_MESSAGE];
+        int prefix = std::snprintf(buffer, sizeof(buffer), "[%s][%s] ", levelName(level), categoryName(category));
+        int body = 0;
+        if constexpr (sizeof...(Args) == 0) {
+            body = std::snprintf(buffer + prefix, sizeof(buffer) - prefix, "%s", format);
+        } else {
+            body = std::snprintf(buffer + prefix, sizeof(buffer) - prefix, format, args...);
+        }
+        if (body < 0) body = 0;
+        size_t length = std::min(static_cast<size_t>(prefix + body), sizeof(buffer) - 1);
+        log(buffer, length);
+    }
+
+    /**
+     * @brief Runtime filter: is this level enabled for this category?
+     */
+    bool isEnabled(LogLevel level, LogCategory category) const {
+        return static_cast<int>(level) >= categoryLevels[static_cast<int>(category)].load(std::memory_order_relaxed);
+    }
+
+    void setMinLevel(LogLevel level);
+    void setCategoryLevel(LogCategory category, LogLevel level);
+
+    static const char* levelName(LogLevel level);
+    static const char* categoryName(LogCategory category);
+
+    /**
+     * @brief Block until everything logged so far is written and flushed.
+     */
+    void flush();
     void close();
 
+    void setFlushPolicy(FlushPolicy policy, std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy.store(policy, std::memory_order_relaxed); }
+
+    // Counters
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    uint64_t getBlockedCount() const { return blocked.load(std::memory_order_relaxed); }
+    uint64_t getWrittenCount() const { return written.load(std::memory_order_relaxed); }
+
+    static constexpr size_t QUEUE_CAPACITY = 4096; // power of two
+    static constexpr size_t MAX_MESSAGE = 240;     // longer messages are truncated
+
 private:
-    Logger() : logFile(nullptr) {}
-    ~Logger() { close(); }
-    
-    std::FILE* logFile;
+    static inline thread_local Logger* redirect = nullptr;
+    static inline thread_local bool redirected = false;
+
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        uint32_t length;
+        char text[MAX_MESSAGE];
+    };
+
+    void writerLoop();
+    size_t drainBatch(std::string& batch);
+    void logConsole(const char* message, size_t length);
+
+    std::FILE* logFile = nullptr;
+    std::unique_ptr<Slot[]> slots;
+    std::thread writer;
+    std::atomic<bool> running{false};
+
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0; // writer thread only
+
+    std::atomic<FlushPolicy> flushPolicy{FlushPolicy::Interval};
+    std::atomic<long long> flushIntervalMs{100};
+    std::atomic<OverflowPolicy> overflowPolicy{OverflowPolicy::Drop};
+    std::atomic<uint64_t> flushRequests{0};
+    std::atomic<uint64_t> flushesDone{0};
+
+    // Runtime minimum level per category (default Info)
+    std::atomic<int> categoryLevels[static_cast<int>(LogCategory::Count)] = {
+        static_cast<int>(LogLevel::Info), static_cast<int>(LogLevel::Info), static_cast<int>(LogLevel::Info),
+        static_cast<int>(LogLevel::Info), static_cast<int>(LogLevel::Info)
+    };
+
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> blocked{0};
+    std::atomic<uint64_t> written{0};
 };
 
+#define LOG_AT(level, category, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= LOG_MIN_LEVEL) { \
+            Logger* logger_ = Logger::current(); \
+            if (logger_ && logger_->isEnabled((level), (category))) logger_->logf((level), (category), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_TRACE(category, ...) LOG_AT(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) LOG_AT(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(LogLevel::Error, category, __VA_ARGS__)
+
 #endif /* Logger_hpp */
@@ -2,24 +2,103 @@
 #define Map_hpp
 
 #include "Game.hpp"
-#include "Matrix2D.hpp"
+#include "Grid2D.hpp"
+#include "TextureManager.h"
+#include "Camera.hpp"
+#include <vector>
+
+class ByteWriter;
+class ByteReader;
 
 class Map {
 public:
+    // Size of the built-in map: 800x640 / 32 = 25x20
+    static constexpr int DEFAULT_ROWS = 20;
+    static constexpr int DEFAULT_COLS = 25;
+    static constexpr int TILE_SIZE = 32;
+    static constexpr int CHUNK_TILES = 16; // Chunks are 16x16 tiles (512x512 px)
+
     explicit Map(SDL_Renderer* ren);
     ~Map();
 
-    void LoadMap(int arr[20][25]); // 800x640 / 32 = 25x20
-    void DrawMap();
+    void LoadMap(const Grid2D<int>& tiles); // Takes the size of the grid
+    void DrawMap(const Camera& camera); // Only the chunks inside the camera's view
+
+    int getRows() const { return map.getRows(); }
+    int getCols() const { return map.getCols(); }
+    int getPixelWidth() const { return map.getCols() * TILE_SIZE; }
+    int getPixelHeight() const { return map.getRows() * TILE_SIZE; }
+
+    // Tile edits (invalidate the chunk holding the tile)
+    void setTile(int row, int col, int type);
+    int getTile(int row, int col) const { return map.get(row, col); }
+    const Grid2D<int>& getTiles() const { return map; }
+    
+    /**
+     * @brief Binary form of a tile grid (replays, snapshots); readTiles() throws ResourceError.
+     */
+    static void writeTiles(ByteWriter& out, const Grid2D<int>& tiles);
+    static void readTiles(ByteReader& in, Grid2D<int>& tiles);
+
+    /**
+     * @brief Grass with a horizontal path across the middle (Level::loadDefaultMap()).
+     */
+    static Grid2D<int> defaultTiles(int cols = DEFAULT_COLS, int rows = DEFAULT_ROWS);
+
+    /**
+     * @brief Bumped whenever tiles change, so derived data (flow field) can tell it is stale.
+     */
+    unsigned getRevision() const { return revision; }
+
+    /**
+     * @brief Enemy movement speed on a tile type: dirt path (1) is slow, everything else is grass.
+     */
+    static float getTileSpeed(int type) { return type == 1 ? 1.0f : 2.5f; }
+
+    /**
+     * @brief Mark every cached chunk stale so each re-bakes the next time it is drawn.
+     */
+    void invalidate();
+
+    /**
+     * @brief Drop the chunk textures after the renderer lost its targets/device.
+     */
+    void resetTileLayer();
+
+    // Stats
+    int getBakeCount() const { return bakeCount; }
+    int getChunkCount() const { return static_cast<int>(chunks.size()); }
+    int getChunksDrawn() const { return chunksDrawn; } // last DrawMap
 
 private:
+    // A CHUNK_TILES square of tiles pre-rendered into one target texture
+    struct Chunk {
+        TextureHandle texture;
+        bool dirty = true;
+    };
+
+    void resizeChunks();
+    bool bakeChunk(int chunkRow, int chunkCol);
+    // Draw tiles [row0, row1) x [col0, col1) with screen = (world - origin) * scale
+    void drawTiles(int row0, int row1, int col0, int col1, float originX, float originY, float scale);
+
     SDL_FRect src, dest;
-    SDL_Texture* dirt;
-    SDL_Texture* grass;
-    SDL_Texture* water;
+    TextureHandle dirt;
+    TextureHandle grass;
+    TextureHandle water;
     
-    Matrix2D<int, 20, 25> map;
+    Grid2D<int> map;
     SDL_Renderer* renderer;
+
+    // Chunks are baked lazily, only once they come into view
+    std::vector<Chunk> chunks; // row-major, chunkCols per row
+    int chunkRows = 0;
+    int chunkCols = 0;
+    bool layerUnsupported = false; // render targets unavailable: draw per tile
+    int bakeCount = 0;
+    int chunksDrawn = 0;
+
+    unsigned revision = 0;
 };
 
 #endif /* Map_hpp */
@@ -0,0 +1,145 @@
+#ifndef ObjectPool_hpp
+#define ObjectPool_hpp
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief Fixed-capacity pool for short-lived objects (projectiles, explosions).
+ *
+ * All objects are copied from a prototype up front, so textures are bound
+ * once and steady-state spawning does no heap allocation. acquire() hands
+ * out a free slot for the caller to re-arm; releaseInactive() returns
+ * slots whose object went inactive. Live objects are visited in the order
+ * they were acquired.
+ *
+ * @tparam T Pooled type; must be copy-constructible and have isActive().
+ */
+template <typename T>
+class ObjectPool {
+public:
+    ObjectPool(size_t capacity, const T& prototype) {
+        slots.reserve(capacity);
+        freeList.reserve(capacity);
+        live.reserve(capacity);
+        seen.resize(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots.push_back(prototype);
+        }
+        // Hand out low indices first
+        for (size_t i = capacity; i > 0; --i) {
+            freeList.push_back(static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    /**
+     * @brief Take a free object, or nullptr when the pool is exhausted.
+     */
+    T* acquire() {
+        if (freeList.empty()) {
+            overflows++;
+            return nullptr;
+        }
+        uint32_t idx = freeList.back();
+        freeList.pop_back();
+        live.push_back(idx);
+        if (live.size() > highWater) highWater = live.size();
+        return &slots[idx];
+    }
+
+    /**
+     * @brief Return every inactive live object to the free list.
+     */
+    void releaseInactive() {
+        size_t out = 0;
+        for (uint32_t idx : live) {
+            if (slots[idx].isActive()) live[out++] = idx;
+            else freeList.push_back(idx);
+        }
+        live.resize(out);
+    }
+
+    /**
+     * @brief Release everything (level reset).
+     */
+    void clear() {
+        for (uint32_t idx : live) freeList.push_back(idx);
+        live.clear();
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) {
+        for (uint32_t idx : live) fn(slots[idx]);
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (uint32_t idx : live) fn(slots[idx]);
+    }
+
+    /**
+     * @brief Write the bookkeeping and every live object (Level snapshots).
+     * The free list goes too: its order decides which slot acquire() hands out next.
+     */
+    template <typename Writer>
+    void saveState(Writer& out) const {
+        out.varint(slots.size());
+        out.varint(highWater);
+        out.varint(overflows);
+        out.varint(live.size());
+        for (uint32_t idx : live) {
+            out.varint(idx);
+            slots[idx].saveState(out);
+        }
+        out.varint(freeList.size());
+        for (uint32_t idx : freeList) out.varint(idx);
+    }
+
+    /**
+     * @brief Inverse of saveState(); reuses the existing slots, no allocation.
+     * Every slot must be listed exactly once, live or free: a slot handed
+     * out twice would be updated twice and given to two owners.
+     */
+    template <typename Reader>
+    void loadState(Reader& in) {
+        if (in.varint() != slots.size()) in.fail("pool capacity mismatch");
+        highWater = static_cast<size_t>(in.varint());
+        overflows = static_cast<size_t>(in.varint());
+        std::fill(seen.begin(), seen.end(), false);
+        auto slotIndex = [&]() {
+            uint64_t idx = in.varint();
+            if (idx >= slots.size()) in.fail("pool slot out of range");
+            if (seen[idx]) in.fail("pool slot listed twice");
+            seen[idx] = true;
+            return static_cast<uint32_t>(idx);
+        };
+        live.resize(in.count(slots.size(), "pooled objects"));
+        for (uint32_t& idx : live) {
+            idx = slotIndex();
+            slots[idx].loadState(in);
+        }
+        size_t freeCount = in.count(slots.size() - live.size(), "free slots");
+        if (live.size() + freeCount != slots.size()) in.fail("pool slots missing");
+        freeList.resize(freeCount);
+        for (uint32_t& idx : freeList) idx = slotIndex();
+    }
+
+    // Counters
+    size_t size() const { return live.size(); }
+    size_t capacity() const { return slots.size(); }
+    size_t getHighWater() const { return highWater; }
+    size_t getOverflowCount() const { return overflows; }
+
+private:
+    std::vector<T> slots;
+    std::vector<uint32_t> freeList;
+    std::vector<uint32_t> live;
+    std::vector<bool> seen; // loadState() scratch, one bit per slot
+
+    size_t highWater = 0;
+    size_t overflows = 0;
+};
+
+#endif /* ObjectPool_hpp */
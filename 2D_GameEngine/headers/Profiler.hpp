@@ -0,0 +1,134 @@
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+// Set from CMake (ENABLE_PROFILER). When 0, PROFILE_SCOPE expands to nothing.
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+
+/**
+ * @brief Scoped-timer frame profiler.
+ *
+ * Each named phase keeps its last HISTORY durations in a ring buffer, from
+ * which min/avg/p99/max are computed on demand. While a trace capture is
+ * running, every timed scope is also kept as an event for export in the
+ * chrome://tracing JSON format. Stats can be drawn as an on-screen overlay
+ * or written to CSV.
+ *
+ * Instrument code with PROFILE_SCOPE("Phase"); it times until the end of
+ * the enclosing block.
+ */
+class Profiler {
+public:
+    static constexpr size_t HISTORY = 256;            // samples per phase used for stats
+    static constexpr size_t MAX_PHASES = 64;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20; // capture stops growing past this
+
+    struct Stats {
+        std::string name;
+        uint64_t count;  // total samples since reset
+        double minUs;    // over the last HISTORY samples
+        double avgUs;
+        double p99Us;
+        double maxUs;
+    };
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Id for a phase name; the same name always maps to the same id.
+     */
+    int registerPhase(const char* name);
+    void record(int phase, uint64_t startNs, uint64_t durationNs);
+
+    std::vector<Stats> getStats() const;
+    void reset();
+
+    // Chrome trace capture
+    void startTrace();
+    void stopTrace();
+    bool isTracing() const { return tracing; }
+    size_t getTraceEventCount() const;
+
+    // Export; return false (and log a warning) when the file can't be written
+    bool writeChromeTrace(const char* path) const;
+    bool writeCsv(const char* path) const;
+
+    /**
+     * @brief Draw a stats table with SDL_RenderDebugText at (x, y).
+     */
+    void drawOverlay(SDL_Renderer* ren, float x, float y) const;
+
+private:
+    Profiler() = default;
+
+    struct Phase {
+        std::string name;
+        uint64_t samples[HISTORY];
+        size_t next = 0;
+        uint64_t count = 0;
+    };
+
+    struct TraceEvent {
+        int phase;
+        uint32_t thread;
+        uint64_t startNs;
+        uint64_t durationNs;
+    };
+
+    static uint32_t threadIndex();
+
+    mutable std::mutex mutex;
+    std::vector<Phase> phases;
+    std::vector<TraceEvent> events;
+    uint64_t traceStartNs = 0;
+    bool tracing = false;
+};
+
+/**
+ * @brief RAII timer behind PROFILE_SCOPE.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(int phase) : phase(phase), start(Profiler::nowNs()) {}
+    ~ProfileScope() { Profiler::getInstance().record(phase, start, Profiler::nowNs() - start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int phase;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if ENABLE_PROFILER
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(profilePhase_, __LINE__) = Profiler::getInstance().registerPhase(name); \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profilePhase_, __LINE__))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif /* Profiler_hpp */
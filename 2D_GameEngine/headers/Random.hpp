@@ -0,0 +1,68 @@
+#ifndef Random_hpp
+#define Random_hpp
+
+#include <cstdint>
+
+/**
+ * @brief Small, fast, seedable PRNG (PCG32, XSH-RR variant).
+ *
+ * Each Level owns one, so runs are reproducible from the seed and
+ * independent levels never share hidden state the way libc rand() does.
+ * The full state is two integers and can be saved and restored.
+ */
+class Random {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 0x853c49e6748fea9bULL;
+
+    struct State {
+        uint64_t state;
+        uint64_t inc;
+    };
+
+    explicit Random(uint64_t seedValue = DEFAULT_SEED, uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        seed(seedValue, stream);
+    }
+
+    void seed(uint64_t seedValue, uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        st.state = 0;
+        st.inc = (stream << 1u) | 1u;
+        next();
+        st.state += seedValue;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = st.state;
+        st.state = old * 6364136223846793005ULL + st.inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    /**
+     * @brief Uniform integer in [0, bound) without modulo bias.
+     */
+    uint32_t nextBelow(uint32_t bound) {
+        if (bound == 0) return 0;
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            uint32_t r = next();
+            if (r >= threshold) return r % bound;
+        }
+    }
+
+    /**
+     * @brief Uniform integer in [lo, hi].
+     */
+    int range(int lo, int hi) {
+        return lo + static_cast<int>(nextBelow(static_cast<uint32_t>(hi - lo + 1)));
+    }
+
+    const State& getState() const { return st; }
+    void setState(const State& s) { st = s; }
+
+private:
+    State st{};
+};
+
+#endif /* Random_hpp */
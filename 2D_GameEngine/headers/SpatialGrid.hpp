@@ -0,0 +1,149 @@
+#ifndef SpatialGrid_hpp
+#define SpatialGrid_hpp
+
+#include <vector>
+#include <algorithm>
+#include "GameObject.h"
+
+/**
+ * @brief Uniform grid over the map for nearest-object queries.
+ *
+ * Objects are bucketed by the cell containing their position; positions
+ * outside the grid are clamped into the border cells. The grid is rebuilt
+ * from scratch each tick with a counting sort into one contiguous array,
+ * so rebuilding is O(n) and reuses its buffers.
+ *
+ * findNearest() gives exactly the same answer as Utils::findNearest over
+ * the same objects in the same order: inactive objects are skipped, the
+ * range is inclusive and ties go to the object inserted last.
+ *
+ * @tparam T Type of GameObject stored (Enemy, Tower).
+ */
+template <typename T>
+class SpatialGrid {
+public:
+    SpatialGrid(int cols, int rows, float cellSize)
+        : cols(cols), rows(rows), cellSize(cellSize), cellStart(cols * rows + 1, 0) {}
+
+    /**
+     * @brief Rebuild the grid from a list of objects (insertion order matters for ties).
+     */
+    template <typename Container>
+    void rebuild(const Container& objects) {
+        items.clear();
+        for (const auto& obj : objects) {
+            T* ptr = &*obj; // raw or smart pointer
+            items.push_back({ptr, cellOf(ptr->getX(), ptr->getY()), static_cast<int>(items.size())});
+        }
+
+        minCol = cols; maxCol = -1;
+        minRow = rows; maxRow = -1;
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        for (const auto& it : items) {
+            cellStart[it.cell + 1]++;
+            int c = it.cell % cols;
+            int r = it.cell / cols;
+            minCol = std::min(minCol, c); maxCol = std::max(maxCol, c);
+            minRow = std::min(minRow, r); maxRow = std::max(maxRow, r);
+        }
+        for (size_t i = 1; i < cellStart.size(); ++i) cellStart[i] += cellStart[i - 1];
+
+        sorted.resize(items.size());
+        cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        for (const auto& it : items) {
+            sorted[cursor[it.cell]++] = it;
+        }
+    }
+
+    /**
+     * @brief Find the nearest active object within range of source.
+     * @return T* Pointer to the nearest object or nullptr.
+     */
+    T* findNearest(const GameObject& source, float range) const {
+        Best best{nullptr, range, -1};
+        if (items.empty()) return nullptr;
+
+        // Sparse grids (e.g. a handful of towers) are cheaper to scan directly
+        if (items.size() <= LINEAR_SCAN_LIMIT) {
+            for (const auto& it : items) consider(source, it, best);
+            return best.obj;
+        }
+
+        int cell = cellOf(source.getX(), source.getY());
+        int cx = cell % cols;
+        int cy = cell / cols;
+
+        // Rings beyond this one cannot contain anything
+        int maxRing = std::max({cx - minCol, maxCol - cx, cy - minRow, maxRow - cy});
+
+        for (int r = 0; r <= maxRing; ++r) {
+            // Everything in ring r is at least (r - 1) cells away; half a pixel of slack
+            // absorbs float rounding so ties are still resolved exactly as a linear scan would.
+            if (r > 1 && (r - 1) * cellSize > best.dist + 0.5f) break;
+
+            int r0 = std::max(cy - r, minRow), r1 = std::min(cy + r, maxRow);
+            for (int row = r0; row <= r1; ++row) {
+                bool edgeRow = (row == cy - r || row == cy + r);
+                if (edgeRow) {
+                    int c0 = std::max(cx - r, minCol), c1 = std::min(cx + r, maxCol);
+                    for (int col = c0; col <= c1; ++col) scanCell(source, row * cols + col, best);
+                } else {
+                    if (cx - r >= minCol) scanCell(source, row * cols + cx - r, best);
+                    if (r > 0 && cx + r <= maxCol) scanCell(source, row * cols + cx + r, best);
+                }
+            }
+        }
+        return best.obj;
+    }
+
+    int getCellSize() const { return static_cast<int>(cellSize); }
+    size_t size() const { return items.size(); }
+
+private:
+    static constexpr size_t LINEAR_SCAN_LIMIT = 16;
+
+    struct Item {
+        T* obj;
+        int cell;
+        int order; // Insertion order, used to break ties like a linear scan
+    };
+
+    struct Best {
+        T* obj;
+        float dist;
+        int order;
+    };
+
+    int cellOf(float x, float y) const {
+        int c = std::clamp(static_cast<int>(std::floor(x / cellSize)), 0, cols - 1);
+        int r = std::clamp(static_cast<int>(std::floor(y / cellSize)), 0, rows - 1);
+        return r * cols + c;
+    }
+
+    static void consider(const GameObject& source, const Item& it, Best& best) {
+        if (!it.obj->isActive()) return;
+        float d = GameObject::distance(source, *it.obj);
+        if (d < best.dist || (d == best.dist && it.order > best.order)) {
+            best = {it.obj, d, it.order};
+        }
+    }
+
+    void scanCell(const GameObject& source, int cell, Best& best) const {
+        for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+            consider(source, sorted[i], best);
+        }
+    }
+
+    int cols;
+    int rows;
+    float cellSize;
+
+    int minCol = 0, maxCol = -1, minRow = 0, maxRow = -1; // Occupied bounds
+
+    std::vector<Item> items;     // Insertion order
+    std::vector<Item> sorted;    // Bucketed by cell
+    std::vector<int> cellStart;  // Prefix sums into sorted
+    std::vector<int> cursor;     // Scratch for the counting sort
+};
+
+#endif /* SpatialGrid_hpp */
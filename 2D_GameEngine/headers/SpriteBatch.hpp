@@ -0,0 +1,87 @@
+#ifndef SpriteBatch_hpp
+#define SpriteBatch_hpp
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Collects a frame's sprites and solid rects, then submits them with
+ * one SDL_RenderGeometry call per (layer, texture) run.
+ *
+ * Layers are drawn in order; inside a layer, quads are grouped by texture
+ * (textures in order of first use, quads in submission order), so a layer
+ * full of goblins costs one draw call instead of one per goblin.
+ * Untextured quads (health bars, projectile dots) form their own group.
+ * Tint goes into the vertex colour, so shared textures are never mutated.
+ * The internal arrays are reused between frames.
+ */
+class SpriteBatch {
+public:
+    enum class Layer : uint8_t {
+        Ground,  // towers
+        Units,   // enemies
+        Effects, // projectiles, explosions
+        Overlay, // health bars
+        Count
+    };
+
+    explicit SpriteBatch(SDL_Renderer* ren) : renderer(ren) {}
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    /**
+     * @brief Queue a textured quad. A null src uses the whole texture.
+     */
+    void draw(Layer layer, SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst,
+              SDL_Color tint = {255, 255, 255, 255});
+
+    /**
+     * @brief Queue a solid colour quad.
+     */
+    void fillRect(Layer layer, const SDL_FRect& dst, SDL_Color color);
+
+    /**
+     * @brief World-to-screen transform for quads queued from now on:
+     * screen = (world - offset) * scale.
+     */
+    void setTransform(float offsetX, float offsetY, float scale);
+
+    /**
+     * @brief Submit everything queued since the last flush, then reset.
+     */
+    void flush();
+
+    // Stats for the last flush
+    int getDrawCalls() const { return lastDrawCalls; }
+    int getQuadCount() const { return lastQuadCount; }
+
+private:
+    struct Quad {
+        SDL_Texture* texture;
+        uint32_t key; // layer << 16 | texture rank within the frame
+        SDL_Vertex vertices[4];
+    };
+
+    uint32_t textureRank(SDL_Texture* texture);
+    void push(Layer layer, SDL_Texture* texture, const SDL_FRect& dst, SDL_Color color,
+              float u0, float v0, float u1, float v1);
+
+    SDL_Renderer* renderer;
+
+    float viewX = 0.0f;
+    float viewY = 0.0f;
+    float viewScale = 1.0f;
+
+    std::vector<Quad> quads;
+    std::vector<uint32_t> order;
+    std::vector<SDL_Texture*> textures; // first-use order this frame
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    int lastDrawCalls = 0;
+    int lastQuadCount = 0;
+};
+
+#endif /* SpriteBatch_hpp */
@@ -0,0 +1,86 @@
+#ifndef Stat_hpp
+#define Stat_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+enum class ModifierOp : uint8_t {
+    Add,     // added to the base
+    Multiply // scales (base + adds)
+};
+
+/**
+ * @brief A numeric stat: a base value plus a stack of modifiers.
+ *
+ * The effective value is (base + sum of Add) * product of Multiply. It is
+ * cached and only recomputed when the base or the modifier stack
+ * changes, so readers pay for one float load. Each modifier gets a
+ * handle on insertion; whoever added it removes exactly that one, so
+ * overlapping effects never have to save and restore values.
+ */
+class Stat {
+public:
+    using ModifierId = uint32_t;
+
+    explicit Stat(float base = 0.0f) : base(base), value(base) {}
+
+    float get() const { return value; }
+    float getBase() const { return base; }
+
+    void setBase(float newBase) {
+        if (newBase == base) return;
+        base = newBase;
+        recompute();
+    }
+
+    ModifierId addModifier(ModifierOp op, float amount) {
+        ModifierId id = nextId++;
+        modifiers.push_back({id, op, amount});
+        recompute();
+        return id;
+    }
+
+    /**
+     * @brief Remove one modifier by handle; false if it is not on this stat.
+     */
+    bool removeModifier(ModifierId id) {
+        auto it = std::find_if(modifiers.begin(), modifiers.end(), [id](const Modifier& m) { return m.id == id; });
+        if (it == modifiers.end()) return false;
+        modifiers.erase(it);
+        recompute();
+        return true;
+    }
+
+    void clearModifiers() {
+        modifiers.clear();
+        recompute();
+    }
+
+    size_t getModifierCount() const { return modifiers.size(); }
+
+private:
+    struct Modifier {
+        ModifierId id;
+        ModifierOp op;
+        float amount;
+    };
+
+    void recompute() {
+        // Insertion order, so the same modifiers always give the same bits
+        float add = 0.0f, mul = 1.0f;
+        for (const Modifier& m : modifiers) {
+            if (m.op == ModifierOp::Add) add += m.amount;
+            else mul *= m.amount;
+        }
+        value = (base + add) * mul;
+    }
+
+    float base;
+    float value;
+    std::vector<Modifier> modifiers;
+    ModifierId nextId = 1;
+};
+
+#endif /* Stat_hpp */
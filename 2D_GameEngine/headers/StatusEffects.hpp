@@ -0,0 +1,108 @@
+#ifndef StatusEffects_hpp
+#define StatusEffects_hpp
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Stat.hpp"
+
+// Forward declaration
+class Enemy;
+class CommandBuffer;
+
+/**
+ * @brief Kinds of status effect; the tag indexes per-type tables.
+ */
+enum class EffectType : uint8_t {
+    Slow,
+    Burn,
+    Count
+};
+
+/**
+ * @brief What a new effect does when its target already has one of the same type.
+ */
+enum class StackRule : uint8_t {
+    Ignore,  // keep the running one, drop the new one
+    Refresh, // restart the running one's duration
+    Stack    // run both side by side
+};
+
+// One record per active effect: plain data, no virtuals, no allocation per hit
+
+struct SlowEffect {
+    Enemy* target;
+    int ticksLeft;
+    float factor;
+    Stat::ModifierId modifier; // Multiply by factor on the target's speed, removed when the slow runs out
+};
+
+struct BurnEffect {
+    Enemy* target;
+    int ticksLeft;
+    int damage; // per burn tick
+};
+
+/**
+ * @brief Every active status effect in a level, stored per type.
+ *
+ * Each type lives in its own contiguous array and update() runs one
+ * tight pass per array; expired records are swap-removed. Targets count
+ * their active effects per type (Enemy::getEffectCount), so stack rules
+ * are resolved with an integer lookup, not by scanning or comparing
+ * names.
+ *
+ * Records point at their target, so removeInactive() must run before
+ * dead enemies are destroyed.
+ */
+class StatusEffects {
+public:
+    static constexpr int BURN_INTERVAL = 30; // ticks between burn damage
+
+    static StackRule getRule(EffectType type);
+
+    /**
+     * @brief Multiply target's speed by factor for ticks (Ignore: one slow at a time).
+     */
+    void addSlow(Enemy& target, int ticks, float factor);
+
+    /**
+     * @brief Deal damage every BURN_INTERVAL ticks for ticks (Stack: burns add up).
+     */
+    void addBurn(Enemy& target, int ticks, int damage);
+
+    /**
+     * @brief Advance every effect one tick; burn kills are recorded in commands.
+     * @return Health the burns took off their targets this tick.
+     */
+    int update(CommandBuffer& commands);
+
+    /**
+     * @brief Drop the records of inactive targets.
+     */
+    void removeInactive();
+
+    void clear();
+
+    // Snapshot support: the records in update order, and re-adding saved
+    // ones as they were (no stack rules; ticksLeft as given)
+    const std::vector<SlowEffect>& getSlows() const { return slows; }
+    const std::vector<BurnEffect>& getBurns() const { return burns; }
+    void restoreSlow(Enemy& target, int ticksLeft, float factor);
+    void restoreBurn(Enemy& target, int ticksLeft, int damage);
+
+    size_t count(EffectType type) const;
+    size_t size() const { return slows.size() + burns.size(); }
+
+private:
+    // Applies the stack rule; true if the new effect gets its own record
+    template <typename Record>
+    bool admit(std::vector<Record>& records, Enemy& target, EffectType type, int ticks);
+
+    void expire(Enemy* target, EffectType type);
+
+    std::vector<SlowEffect> slows;
+    std::vector<BurnEffect> burns;
+};
+
+#endif /* StatusEffects_hpp */
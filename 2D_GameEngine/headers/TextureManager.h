@@ -4,10 +4,53 @@
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <string>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief Shared, reference-counted handle to a cached GPU texture.
+ */
+using TextureHandle = std::shared_ptr<SDL_Texture>;
 
 class TextureManager {
 public:
+    /**
+     * @brief Load a texture from disk, bypassing the cache. Caller owns the result.
+     */
     static SDL_Texture* LoadTexture(const char* fileName, SDL_Renderer* ren);
+
+    /**
+     * @brief Get the shared texture for a path, loading it only on first use.
+     *
+     * Failed loads are remembered too, so a missing asset is not retried
+     * from disk on every spawn; each call still throws ResourceError.
+     */
+    static TextureHandle Acquire(const char* fileName, SDL_Renderer* ren);
+
+    /**
+     * @brief Drop cached textures that nobody outside the cache references.
+     */
+    static void Purge();
+
+    /**
+     * @brief Drop every cached texture. Must run before the renderer is destroyed.
+     */
+    static void Clear();
+
+    // Stats
+    static long getRefCount(const std::string& fileName);
+    static int getCachedCount();
+    static int getLoadCount() { return loadCount; }
+
+private:
+    struct Entry {
+        SDL_Renderer* renderer = nullptr;
+        TextureHandle texture;
+        std::string error; // non-empty when the load failed
+    };
+
+    static std::unordered_map<std::string, Entry> cache;
+    static int loadCount;
 };
 
 #endif /* TextureManager_h */
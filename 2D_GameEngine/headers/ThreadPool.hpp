@@ -0,0 +1,127 @@
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief Fixed set of worker threads with one task deque each.
+ *
+ * A worker takes the newest task from its own deque and, when that is
+ * empty, steals the oldest task from another worker's, so a task that
+ * submits more work keeps it local while idle workers pick up the rest.
+ * Tasks submitted from outside the pool are dealt round-robin.
+ *
+ * Tasks belong to a TaskGroup; wait() blocks until every task of the group
+ * has run, executing queued tasks itself in the meantime, so a task may
+ * wait on a group of its own without tying up a worker. A worker waits
+ * only for groups it submitted.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief A set of tasks to wait for. Must outlive its tasks.
+     */
+    class TaskGroup {
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+    private:
+        friend class ThreadPool;
+        std::atomic<size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error; // first exception thrown by a task
+    };
+
+    /**
+     * @param threads Worker count; 0 means one per hardware thread.
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool(); // runs what is still queued, then joins
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return workers.size(); }
+
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * @brief Run queued tasks until the group is done, then rethrow the
+     * first exception one of its tasks threw, if any.
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * @brief body(begin, end) over [0, count) in chunks of grain, the first
+     * on the calling thread; returns when all chunks are done.
+     */
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& body) {
+        grain = std::max<size_t>(grain, 1);
+        if (count <= grain) {
+            if (count > 0) body(size_t{0}, count);
+            return;
+        }
+        // Tasks capture two words, which std::function stores without allocating
+        struct Range {
+            std::remove_reference_t<Fn>* body;
+            size_t count;
+            size_t grain;
+        } range{&body, count, grain};
+        TaskGroup group;
+        for (size_t begin = grain; begin < count; begin += grain) {
+            submit(group, [r = &range, begin] { (*r->body)(begin, std::min(r->count, begin + r->grain)); });
+        }
+        try {
+            body(size_t{0}, grain);
+        } catch (...) {
+            try { wait(group); } catch (...) {}
+            throw;
+        }
+        wait(group);
+    }
+
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group = nullptr;
+    };
+
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    // home: the caller's queue, or queues.size() if it isn't a worker;
+    // only: take nothing but this group's tasks, from home
+    bool tryRunOne(size_t home, const TaskGroup* only);
+    bool take(size_t home, const TaskGroup* only, Task& out);
+    void finish(Task& task);
+    size_t homeQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> nextQueue{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable wake; // work arrived or stopping
+    std::condition_variable done; // some group ran out of tasks
+    bool stopping = false;
+};
+
+#endif /* ThreadPool_hpp */
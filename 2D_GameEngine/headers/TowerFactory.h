@@ -3,6 +3,8 @@
 
 #include "Towers.h"
 #include <memory> 
+#include <cstdio>
+#include <cstring>
 
 enum class TowerType {
     Basic,
@@ -10,6 +12,15 @@ enum class TowerType {
     Fire
 };
 
+/**
+ * @brief A tower to put on the grid before the level starts.
+ */
+struct TowerPlacement {
+    int col = 0;
+    int row = 0;
+    TowerType type = TowerType::Basic;
+};
+
 class TowerFactory {
 public:
     static std::unique_ptr<Tower> createTower(TowerType type, Point2D pos, SDL_Renderer* ren) {
@@ -23,6 +34,22 @@ public:
                 return std::make_unique<Tower>(pos, 15, 150.0f, ren);
         }
     }
+
+    /**
+     * @brief Parse "COL,ROW[,basic|ice|fire]" (the type defaults to basic).
+     */
+    static bool parsePlacement(const char* spec, TowerPlacement& out) {
+        char typeName[16] = "basic";
+        char tail = 0;
+        int matched = std::sscanf(spec, "%d,%d,%15[a-z]%c", &out.col, &out.row, typeName, &tail);
+        if (matched < 2 || matched > 3) return false;
+
+        if (std::strcmp(typeName, "ice") == 0) out.type = TowerType::Ice;
+        else if (std::strcmp(typeName, "fire") == 0) out.type = TowerType::Fire;
+        else if (std::strcmp(typeName, "basic") == 0) out.type = TowerType::Basic;
+        else return false;
+        return true;
+    }
 };
 
 #endif /* TowerFactory_h */
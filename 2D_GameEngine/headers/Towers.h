@@ -2,11 +2,11 @@
 #define Towers_h
 
 #include "GameObject.h"
-#include "Effect.h"
+#include "CommandBuffer.hpp"
 #include "Logger.hpp"
 
 /**
- * @brief Tower that applies SlowEffect.
+ * @brief Tower that slows what it hits.
  */
 class IceTower : public Tower {
 public:
@@ -14,24 +14,22 @@ public:
         : Tower(pos, 5, 800.0f, ren) // Huge range (80% of map)
     {
         // Visual distinction: BLUE (0, 0, 255)
-        if (objTexture) {
-            SDL_SetTextureColorMod(objTexture, 0, 0, 255);
-        }
+        tint = {0, 0, 255, 255};
     }
     
     // Override Attack to apply effect
-    void attack(Enemy& enemy) override {
+    void attack(Enemy& enemy, CommandBuffer& commands) override {
         // Call base damage logic first (optional, or custom)
         // Tower::attack(enemy) deals damage.
         // But we want to also apply effect.
         if (canAttack(enemy)) {
              // Base damage
-             Tower::attack(enemy);
+             Tower::attack(enemy, commands);
              
              // Apply Slow
              // 60 frames = 2 seconds, 0.5 factor
-             enemy.addEffect(std::make_unique<SlowEffect>(60, 0.5f));
-             // Logger::getInstance().log("IceTower hit!");
+             commands.addSlow(enemy, 60, 0.5f);
+             LOG_TRACE(LogCategory::Combat, "IceTower hit!");
         }
     }
     
@@ -39,7 +37,7 @@ public:
 };
 
 /**
- * @brief Tower that applies BurnEffect.
+ * @brief Tower that sets what it hits on fire.
  */
 class FireTower : public Tower {
 public:
@@ -47,22 +45,20 @@ public:
         : Tower(pos, 10, 150.0f, ren) // High damage
     {
         // Visual distinction: ORANGE (255, 165, 0)
-        if (objTexture) {
-             SDL_SetTextureColorMod(objTexture, 255, 165, 0);
-        }
+        tint = {255, 165, 0, 255};
     }
     
     std::unique_ptr<GameObject> clone() const override {
          return std::make_unique<FireTower>(*this);
     }
     
-    void attack(Enemy& enemy) override {
+    void attack(Enemy& enemy, CommandBuffer& commands) override {
         if (canAttack(enemy)) {
-             Tower::attack(enemy);
+             Tower::attack(enemy, commands);
              // Apply Burn
              // 90 frames = 3 seconds, 2 damage per tick
-             enemy.addEffect(std::make_unique<BurnEffect>(90, 2));
-             // Logger::getInstance().log("FireTower hit!");
+             commands.addBurn(enemy, 90, 2);
+             LOG_TRACE(LogCategory::Combat, "FireTower hit!");
         }
     }
     
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <type_traits>
 #include "GameObject.h"
 
 namespace Utils {
@@ -12,21 +13,24 @@ namespace Utils {
  * @brief Template function to find the nearest object of type T from a collection.
  * 
  * @tparam T The specific type of GameObject to find (Enemy, Tower).
+ * @tparam U The stored type; when it already is a T no RTTI check is needed.
  * @param source The source object to measure distance from.
  * @param objects The collection of objects (pointers).
  * @param range Max range to search.
  * @return T* Pointer to the nearest object or nullptr.
  */
-template <typename T>
-T* findNearest(const GameObject& source, const std::vector<std::unique_ptr<GameObject>>& objects, float range) {
+template <typename T, typename U>
+T* findNearest(const GameObject& source, const std::vector<std::unique_ptr<U>>& objects, float range) {
     T* nearest = nullptr;
     float minD = range;
     
     for(const auto& obj : objects) {
         if(!obj->isActive()) continue;
         
-        // Check exact type match via dynamic_cast (RTTI) as requested
-        T* typedObj = dynamic_cast<T*>(obj.get());
+        // Check exact type match via dynamic_cast (RTTI) only for mixed containers
+        T* typedObj = nullptr;
+        if constexpr (std::is_base_of_v<T, U>) typedObj = obj.get();
+        else typedObj = dynamic_cast<T*>(obj.get());
         if(typedObj) {
             float d = GameObject::distance(source, *typedObj);
             if(d <= minD) {
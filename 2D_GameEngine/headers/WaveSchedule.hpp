@@ -0,0 +1,128 @@
+#ifndef WaveSchedule_hpp
+#define WaveSchedule_hpp
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "Random.hpp"
+
+class ByteWriter;
+class ByteReader;
+
+enum class EnemyKind : uint8_t {
+    Goblin,
+    Orc
+};
+
+enum class SpawnLane : uint8_t {
+    Top,
+    Bottom,
+    Left,
+    Right
+};
+
+/**
+ * @brief One wave as written in the waves file.
+ */
+struct WaveDef {
+    int startTick = 0;     // tick of the first burst
+    int count = 0;         // enemies in the wave
+    int intervalTicks = 1; // ticks between bursts
+    int burst = 1;         // enemies per burst
+    std::vector<std::pair<EnemyKind, int>> mix;   // kind, weight
+    std::vector<SpawnLane> lanes;
+
+    bool operator==(const WaveDef&) const = default;
+};
+
+/**
+ * @brief A single precomputed spawn.
+ */
+struct SpawnEvent {
+    int tick;
+    EnemyKind kind;
+    int x;
+    int y;
+};
+
+/**
+ * @brief Spawn timeline compiled from wave definitions at level load.
+ *
+ * compile() expands every wave into individual spawns (kind, lane and
+ * position drawn from the level's Random up front) and sorts them by
+ * tick. Level::update then only advances a cursor over the events due
+ * this tick, so per-tick cost is O(spawns this tick).
+ *
+ * Waves file format, one wave per line, '#' starts a comment:
+ *
+ *   wave start=749 count=8 interval=150 burst=1 mix=goblin:1,orc:1 lanes=top,bottom,left,right
+ *
+ * Times are in simulation ticks (TICKS_PER_SECOND per second). mix
+ * weights are relative; lanes are the map edges enemies enter from.
+ */
+class WaveSchedule {
+public:
+    // Limits on what a waves file may ask for, so a typo can't exhaust
+    // memory or overflow the int tick arithmetic
+    static constexpr int MAX_SPAWNS = 1 << 16; // enemies, over all waves
+    static constexpr int MAX_TICK = 1 << 24;   // last spawn (over 6 days of play)
+
+    /**
+     * @brief Parse wave definitions; throws ResourceError naming the bad line
+     * (also for waves past MAX_TICK or more than MAX_SPAWNS enemies in all).
+     */
+    static std::vector<WaveDef> parse(std::istream& in, const std::string& sourceName);
+
+    /**
+     * @brief Read and parse a waves file; throws ResourceError if missing or malformed.
+     */
+    static std::vector<WaveDef> loadFile(const char* path);
+
+    /**
+     * @brief Binary form of a wave list (replays, snapshots); read() throws
+     * ResourceError if the data is corrupt or breaks the limits parse() applies.
+     */
+    static void write(ByteWriter& out, const std::vector<WaveDef>& waves);
+    static std::vector<WaveDef> read(ByteReader& in);
+
+    /**
+     * @brief The built-in wave: one Goblin or Orc from a random edge every
+     * 150 ticks after the prep phase, until the level timer runs out.
+     */
+    static WaveDef defaultWave(int prepTicks, int levelTicks);
+
+    /**
+     * @brief Expand waves into the sorted timeline and rewind the cursor.
+     * Waves parse() would reject are skipped.
+     */
+    void compile(const std::vector<WaveDef>& waves, Random& rng, int worldWidth, int worldHeight);
+
+    /**
+     * @brief Call spawn(event) for every event due at or before tick, in order.
+     */
+    template <typename Fn>
+    void consume(int tick, Fn&& spawn) {
+        while (cursor < events.size() && events[cursor].tick <= tick) {
+            spawn(events[cursor++]);
+        }
+    }
+
+    void rewind() { cursor = 0; }
+    
+    // Events already consumed; seek() resumes a restored level mid-timeline
+    size_t getCursor() const { return cursor; }
+    void seek(size_t position) { cursor = std::min(position, events.size()); }
+
+    const std::vector<SpawnEvent>& getEvents() const { return events; }
+    size_t size() const { return events.size(); }
+    size_t remaining() const { return events.size() - cursor; }
+
+private:
+    std::vector<SpawnEvent> events;
+    size_t cursor = 0;
+};
+
+#endif /* WaveSchedule_hpp */
@@ -0,0 +1,86 @@
+#include "BatchRunner.hpp"
+#include "ThreadPool.hpp"
+#include "Level.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <utility>
+
+BatchResult BatchRunner::runOne(const BatchScenario& scenario, const std::vector<TowerPlacement>& layout) {
+    Level level(nullptr, 1, scenario.seed);
+    level.setLogger(scenario.logger);
+    if (scenario.tiles.empty()) level.loadDefaultMap();
+    else level.loadMap(scenario.tiles);
+    if (!scenario.waves.empty()) level.setWaves(scenario.waves);
+
+    for (const TowerPlacement& t : layout) {
+        level.selectTowerType(t.type);
+        level.placeTower(t.col, t.row);
+    }
+
+    BatchResult result;
+    result.towersPlaced = level.getTowerCount();
+    bool standing = result.towersPlaced > 0;
+    int limit = scenario.maxTicks > 0 ? scenario.maxTicks : INT_MAX;
+
+    auto start = std::chrono::steady_clock::now();
+    while (result.ticks < limit && !level.isGameOver()) {
+        level.update();
+        result.ticks++;
+        if (standing && level.getTowerCount() == 0) {
+            standing = false;
+            result.survivedTicks = level.getFrame();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (standing) result.survivedTicks = level.getFrame();
+    result.towersLeft = level.getTowerCount();
+    result.damageDealt = level.getDamageDealt();
+    result.won = level.isGameWon();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    result.ticksPerSecond = seconds > 0.0 ? result.ticks / seconds : 0.0;
+    return result;
+}
+
+std::vector<BatchResult> BatchRunner::run(const BatchScenario& scenario,
+                                          const std::vector<std::vector<TowerPlacement>>& layouts) {
+    // Each task writes only its own slot
+    std::vector<BatchResult> results(layouts.size());
+    ThreadPool::TaskGroup group;
+    for (size_t i = 0; i < layouts.size(); i++) {
+        pool.submit(group, [&scenario, &layouts, &results, i] {
+            results[i] = runOne(scenario, layouts[i]);
+            results[i].layout = i;
+        });
+    }
+    pool.wait(group);
+    return results;
+}
+
+std::vector<std::vector<TowerPlacement>> BatchRunner::randomLayouts(const Grid2D<int>& tiles, size_t count,
+                                                                    int maxTowers, Random& rng) {
+    std::vector<std::pair<int, int>> grass; // (col, row)
+    for (int r = 0; r < tiles.getRows(); r++) {
+        for (int c = 0; c < tiles.getCols(); c++) {
+            if (tiles.get(r, c) == 0) grass.emplace_back(c, r);
+        }
+    }
+
+    std::vector<std::vector<TowerPlacement>> layouts(count);
+    size_t towers = std::min(grass.size(), static_cast<size_t>(std::max(maxTowers, 0)));
+    for (auto& layout : layouts) {
+        // Partial shuffle: the first `towers` entries are a random distinct pick
+        for (size_t i = 0; i < towers; i++) {
+            size_t j = i + rng.nextBelow(static_cast<uint32_t>(grass.size() - i));
+            std::swap(grass[i], grass[j]);
+            TowerPlacement t;
+            t.col = grass[i].first;
+            t.row = grass[i].second;
+            t.type = static_cast<TowerType>(rng.range(0, static_cast<int>(TowerType::Fire)));
+            layout.push_back(t);
+        }
+    }
+    return layouts;
+}
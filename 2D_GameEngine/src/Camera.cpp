@@ -0,0 +1,47 @@
+#include "Camera.hpp"
+
+#include <algorithm>
+
+Camera::Camera(float viewWidth, float viewHeight) : viewW(viewWidth), viewH(viewHeight) {}
+
+void Camera::setViewport(float width, float height) {
+    if (width == viewW && height == viewH) return;
+    viewW = std::max(width, 1.0f);
+    viewH = std::max(height, 1.0f);
+    clamp();
+}
+
+void Camera::setWorldSize(float width, float height) {
+    worldW = width;
+    worldH = height;
+    clamp();
+}
+
+void Camera::pan(float dx, float dy) {
+    x += dx / zoom;
+    y += dy / zoom;
+    clamp();
+}
+
+void Camera::zoomBy(float factor, float screenX, float screenY) {
+    SDL_FPoint anchor = toWorld(screenX, screenY);
+    zoom = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+    x = anchor.x - screenX / zoom;
+    y = anchor.y - screenY / zoom;
+    clamp();
+}
+
+void Camera::ensureVisible(const SDL_FRect& world) {
+    SDL_FRect view = getView();
+    if (world.x < view.x) x = world.x;
+    else if (world.x + world.w > view.x + view.w) x = world.x + world.w - view.w;
+    if (world.y < view.y) y = world.y;
+    else if (world.y + world.h > view.y + view.h) y = world.y + world.h - view.h;
+    clamp();
+}
+
+void Camera::clamp() {
+    // Pin to the top-left when the world is smaller than the view
+    x = std::max(0.0f, std::min(x, worldW - viewW / zoom));
+    y = std::max(0.0f, std::min(y, worldH - viewH / zoom));
+}
@@ -0,0 +1,112 @@
+#include "EnemyMotion.hpp"
+#include "GameObject.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define ENEMY_MOTION_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ENEMY_MOTION_SSE 1
+#endif
+
+void EnemyMotion::load(const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    // Size once and fill by index: five push_backs per enemy cost more
+    // than the kernel itself at these counts
+    const size_t cap = enemies.size();
+    owners.resize(cap);
+    x.resize(cap); y.resize(cap); speed.resize(cap);
+    targetX.resize(cap); targetY.resize(cap);
+
+    size_t n = 0;
+    for (const auto& e : enemies) {
+        if (!e->isActive()) continue;
+        const Point2D& target = e->getTarget();
+        owners[n] = e.get();
+        x[n] = e->getX();
+        y[n] = e->getY();
+        speed[n] = e->getSpeed();
+        targetX[n] = target.getX();
+        targetY[n] = target.getY();
+        ++n;
+    }
+
+    owners.resize(n);
+    x.resize(n); y.resize(n); speed.resize(n);
+    targetX.resize(n); targetY.resize(n);
+}
+
+void EnemyMotion::step() {
+    stepSimd(x.data(), y.data(), speed.data(), targetX.data(), targetY.data(), x.size());
+}
+
+void EnemyMotion::store() const {
+    for (size_t i = 0; i < owners.size(); ++i) {
+        owners[i]->setPos(x[i], y[i]);
+    }
+}
+
+// Reference kernel: identical to Enemy::move()
+void EnemyMotion::stepScalar(float* px, float* py, const float* speed,
+                             const float* tx, const float* ty, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        float dx = tx[i] - px[i];
+        float dy = ty[i] - py[i];
+        float dist = std::sqrt(dx*dx + dy*dy);
+
+        if (dist > speed[i]) {
+            px[i] += (dx/dist) * speed[i];
+            py[i] += (dy/dist) * speed[i];
+        }
+    }
+}
+
+void EnemyMotion::stepSimd(float* px, float* py, const float* speed,
+                           const float* tx, const float* ty, size_t count) {
+    size_t i = 0;
+#if defined(ENEMY_MOTION_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(px + i);
+        __m256 y = _mm256_loadu_ps(py + i);
+        __m256 s = _mm256_loadu_ps(speed + i);
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(tx + i), x);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ty + i), y);
+        __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+
+        // Lanes where dist <= speed keep their position (their division result is unused)
+        __m256 moving = _mm256_cmp_ps(dist, s, _CMP_GT_OQ);
+        __m256 nx = _mm256_add_ps(x, _mm256_mul_ps(_mm256_div_ps(dx, dist), s));
+        __m256 ny = _mm256_add_ps(y, _mm256_mul_ps(_mm256_div_ps(dy, dist), s));
+        _mm256_storeu_ps(px + i, _mm256_blendv_ps(x, nx, moving));
+        _mm256_storeu_ps(py + i, _mm256_blendv_ps(y, ny, moving));
+    }
+#elif defined(ENEMY_MOTION_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(px + i);
+        __m128 y = _mm_loadu_ps(py + i);
+        __m128 s = _mm_loadu_ps(speed + i);
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(tx + i), x);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ty + i), y);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+
+        // SSE2 has no blendv: select with and/andnot/or
+        __m128 moving = _mm_cmpgt_ps(dist, s);
+        __m128 nx = _mm_add_ps(x, _mm_mul_ps(_mm_div_ps(dx, dist), s));
+        __m128 ny = _mm_add_ps(y, _mm_mul_ps(_mm_div_ps(dy, dist), s));
+        _mm_storeu_ps(px + i, _mm_or_ps(_mm_and_ps(moving, nx), _mm_andnot_ps(moving, x)));
+        _mm_storeu_ps(py + i, _mm_or_ps(_mm_and_ps(moving, ny), _mm_andnot_ps(moving, y)));
+    }
+#endif
+    // Tail (or the whole batch when no SIMD is available)
+    stepScalar(px, py, speed, tx, ty, i, count);
+}
+
+const char* EnemyMotion::simdName() {
+#if defined(ENEMY_MOTION_AVX2)
+    return "AVX2";
+#elif defined(ENEMY_MOTION_SSE)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
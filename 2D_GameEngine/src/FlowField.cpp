@@ -0,0 +1,112 @@
+#include "FlowField.hpp"
+#include "Map.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+// Entering a tile costs the ticks needed to cross it, in tenths
+constexpr float COST_SCALE = 10.0f;
+
+}
+
+FlowField::FlowField(int cols, int rows, int tileSize)
+    : cols(cols), rows(rows), tileSize(tileSize), cost(rows, cols, 1), dist(rows, cols, UNREACHABLE)
+{
+    heap.reserve(dist.bufferSize());
+}
+
+void FlowField::push(uint32_t d, int tile) {
+    heap.push_back({d, tile});
+    std::push_heap(heap.begin(), heap.end(), std::greater<Node>());
+}
+
+void FlowField::rebuild(const Map& map, const std::vector<int>& goalTiles) {
+    if (map.getRows() != rows || map.getCols() != cols) {
+        rows = map.getRows();
+        cols = map.getCols();
+        cost.resize(rows, cols, 1);
+        dist.resize(rows, cols, UNREACHABLE);
+        heap.reserve(dist.bufferSize());
+    }
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            float speed = Map::getTileSpeed(map.getTile(r, c));
+            cost.at(r, c) = speed > 0.0f
+                ? static_cast<uint16_t>(std::max(1.0f, std::round(COST_SCALE / speed)))
+                : 0;
+        }
+    }
+    mapRevision = map.getRevision();
+
+    dist.fill(UNREACHABLE);
+    heap.clear();
+    for (int g : goalTiles) {
+        if (g < 0 || g >= static_cast<int>(dist.bufferSize()) || dist[g] == 0) continue;
+        dist[g] = 0;
+        push(0, g);
+    }
+    propagate();
+    rebuilds++;
+}
+
+void FlowField::addGoal(int tile) {
+    if (tile < 0 || tile >= static_cast<int>(dist.bufferSize()) || dist[tile] == 0) return;
+    heap.clear();
+    dist[tile] = 0;
+    push(0, tile);
+    // Only tiles that end up closer to the new goal are touched
+    propagate();
+    incrementals++;
+}
+
+void FlowField::propagate() {
+    static const int dr[4] = {-1, 1, 0, 0};
+    static const int dc[4] = {0, 0, -1, 1};
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Node>());
+        Node n = heap.back();
+        heap.pop_back();
+        if (n.dist != dist[n.tile]) continue; // stale entry
+
+        int r = getRow(n.tile);
+        int c = getCol(n.tile);
+        for (int k = 0; k < 4; ++k) {
+            int nr = r + dr[k];
+            int nc = c + dc[k];
+            if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) continue;
+            int next = toTile(nr, nc);
+            if (cost[next] == 0) continue;
+            uint32_t d = n.dist + cost[next];
+            if (d < dist[next]) {
+                dist[next] = d;
+                push(d, next);
+            }
+        }
+    }
+}
+
+int FlowField::tileAt(float x, float y) const {
+    int c = static_cast<int>(std::floor(x / tileSize));
+    int r = static_cast<int>(std::floor(y / tileSize));
+    c = std::clamp(c, 0, cols - 1);
+    r = std::clamp(r, 0, rows - 1);
+    return toTile(r, c);
+}
+
+int FlowField::nextTile(int tile) const {
+    int best = tile;
+    uint32_t bestDist = dist[tile];
+    int r = getRow(tile);
+    int c = getCol(tile);
+    // Fixed neighbour order keeps ties deterministic
+    if (r > 0 && dist[tile - cols] < bestDist) { best = tile - cols; bestDist = dist[best]; }
+    if (r < rows - 1 && dist[tile + cols] < bestDist) { best = tile + cols; bestDist = dist[best]; }
+    if (c > 0 && dist[tile - 1] < bestDist) { best = tile - 1; bestDist = dist[best]; }
+    if (c < cols - 1 && dist[tile + 1] < bestDist) { best = tile + 1; bestDist = dist[best]; }
+    return best;
+}
@@ -3,12 +3,13 @@
 #include "TextureManager.h"
 #include "Level.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
 #include <sstream>
 #include <fstream>
 #include <string>
 #include <cstdio>
 
-Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), gameState(MENU), menuBg(nullptr), btnStart(nullptr), btnQuit(nullptr), btnManual(nullptr), startRect{0,0,0,0}, quitRect{0,0,0,0}, manualRect{0,0,0,0}, level(nullptr)
+Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), gameState(MENU), startRect{0,0,0,0}, quitRect{0,0,0,0}, manualRect{0,0,0,0}, level(nullptr)
 {}
 
 Game::~Game()
@@ -25,12 +26,12 @@ void Game::init(const char *title, int xpos, int ypos, int width, int height, bo
     }
     if(SDL_Init(SDL_INIT_VIDEO))
     {
-        Logger::getInstance().log("Subsystem Initialised!...");
+        LOG_INFO(LogCategory::Game, "Subsystem Initialised!...");
 
         window = SDL_CreateWindow(title, width, height, static_cast<SDL_WindowFlags>(flags)); 
         if(window)
         {
-            Logger::getInstance().log("window created!");
+            LOG_INFO(LogCategory::Game, "window created!");
             SDL_SetWindowPosition(window, xpos, ypos);
         }
 
@@ -38,7 +39,11 @@ void Game::init(const char *title, int xpos, int ypos, int width, int height, bo
         if(renderer)
         {
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-            Logger::getInstance().log("Renderer created!");
+            LOG_INFO(LogCategory::Game, "Renderer created!");
+            // Frame pacing comes from vsync; the simulation has its own fixed tick
+            if (!SDL_SetRenderVSync(renderer, 1)) {
+                LOG_WARN(LogCategory::Game, "VSync unavailable: %s", SDL_GetError());
+            }
         }
         isRunning = true;
 
@@ -47,37 +52,27 @@ void Game::init(const char *title, int xpos, int ypos, int width, int height, bo
     }
     
     // Load Menu Assets
-    menuBg = TextureManager::LoadTexture("assets/menu_bg.bmp", renderer);
-    btnStart = TextureManager::LoadTexture("assets/btn_start.bmp", renderer);
-    btnQuit = TextureManager::LoadTexture("assets/btn_quit.bmp", renderer);
-    btnManual = TextureManager::LoadTexture("assets/btn_manual.png", renderer);
+    menuBg = TextureManager::Acquire("assets/menu_bg.bmp", renderer);
+    btnStart = TextureManager::Acquire("assets/btn_start.bmp", renderer);
+    btnQuit = TextureManager::Acquire("assets/btn_quit.bmp", renderer);
+    btnManual = TextureManager::Acquire("assets/btn_manual.png", renderer);
     
     startRect = {300.0f, 200.0f, 200.0f, 64.0f};
     manualRect = {300.0f, 300.0f, 200.0f, 64.0f};
     quitRect = {300.0f, 400.0f, 200.0f, 64.0f};
     
     // Init Level
+    workers = std::make_unique<ThreadPool>();
     level = new Level(renderer, 1);
-    
-    // Simple Map using Matrix2D methods
-    Matrix2D<int, 20, 25> mapMatrix;
-    mapMatrix.fill(0); // Fill with Grass (0)
-    for(int c=0; c<25; c++) mapMatrix.set(10, c, 1); // Set Path (1)
-
-    
-    int mapArr[20][25];
-    for(int r=0; r<20; r++)
-        for(int c=0; c<25; c++)
-            mapArr[r][c] = mapMatrix.get(r,c);
-            
-    level->loadMap(mapArr);
+    level->setThreadPool(workers.get());
+    level->loadDefaultMap();
+    level->loadWaves("assets/waves.txt");
     
     // Use getCount
-    {
-        char message[64];
-        std::snprintf(message, sizeof(message), "Total GameObjects: %d", GameObject::getCount());
-        Logger::getInstance().log(message);
-    }
+    LOG_INFO(LogCategory::Game, "Total GameObjects: %d", GameObject::getCount());
+    LOG_INFO(LogCategory::Resource, "Cached textures: %d (disk loads: %d)",
+             TextureManager::getCachedCount(), TextureManager::getLoadCount());
+    LOG_INFO(LogCategory::Game, "Level seed: %llu", static_cast<unsigned long long>(level->getSeed()));
     
     gameState = MENU;
 }
@@ -100,7 +95,7 @@ void Game::handleEvents()
                     if (mx >= startRect.x && mx <= startRect.x + startRect.w &&
                         my >= startRect.y && my <= startRect.y + startRect.h) {
                         gameState = PLAYING;
-                        Logger::getInstance().log("Game Started!");
+                        LOG_INFO(LogCategory::Game, "Game Started!");
                     }
                     
                     // Check Manual
@@ -115,11 +110,11 @@ void Game::handleEvents()
                             manualContent = buffer.str();
                             manualFile.close();
                         } else {
-                            Logger::getInstance().log("Failed to load assets/manual.txt");
+                            LOG_WARN(LogCategory::Resource, "Failed to load assets/manual.txt");
                         }
                             
                         SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Game Manual", manualContent.c_str(), window);
-                        Logger::getInstance().log("Manual Opened.");
+                        LOG_INFO(LogCategory::Game, "Manual Opened.");
                     }
                     
                     // Check Quit
@@ -133,10 +128,34 @@ void Game::handleEvents()
                 }
             }
                 break;
+            case SDL_EVENT_MOUSE_WHEEL:
+                if (gameState == PLAYING && level) {
+                    level->handleMouseWheel(event.wheel.mouse_x, event.wheel.mouse_y, event.wheel.y);
+                }
+                break;
+            case SDL_EVENT_RENDER_TARGETS_RESET:
+            case SDL_EVENT_RENDER_DEVICE_RESET:
+                if (level) level->onRenderTargetsReset(event.type == SDL_EVENT_RENDER_DEVICE_RESET);
+                break;
             case SDL_EVENT_KEY_DOWN:
+#if ENABLE_PROFILER
+                if (event.key.key == SDLK_F3) {
+                    showProfiler = !showProfiler;
+                    break;
+                }
+                if (event.key.key == SDLK_F4) {
+                    toggleTraceCapture();
+                    break;
+                }
+#endif
                 if (gameState == PLAYING) {
                     if (event.key.key == SDLK_ESCAPE) {
                         gameState = MENU;
+                    } else if (event.key.key == SDLK_F) {
+                        fastForward = !fastForward;
+                        LOG_INFO(LogCategory::Game, "Fast-forward %s", fastForward ? "on" : "off");
+                    } else if (event.key.key == SDLK_F5 || event.key.key == SDLK_F9) {
+                        quickSaveOrLoad(event.key.key == SDLK_F9);
                     } else {
                         // Pass other keys to Level
                         if (level) level->handleInput(event.key.key);
@@ -148,6 +167,59 @@ void Game::handleEvents()
         }
     }
 }
+void Game::toggleTraceCapture()
+{
+    Profiler& profiler = Profiler::getInstance();
+    if (!profiler.isTracing()) {
+        profiler.startTrace();
+        LOG_INFO(LogCategory::Game, "Profiler trace capture started");
+        return;
+    }
+    profiler.stopTrace();
+    profiler.writeChromeTrace("profile_trace.json");
+    profiler.writeCsv("profile_stats.csv");
+    LOG_INFO(LogCategory::Game, "Profiler trace saved (%zu events): profile_trace.json, profile_stats.csv",
+             profiler.getTraceEventCount());
+}
+
+void Game::startRecording(const char* path)
+{
+    if (level && level->startRecording()) recordPath = path;
+}
+
+bool Game::startReplay(const char* path)
+{
+    if (!level) return false;
+    try {
+        if (!level->startPlayback(InputLog::loadFile(path))) return false;
+    } catch (const ResourceError& e) {
+        LOG_WARN(LogCategory::Resource, "%s", e.what());
+        return false;
+    }
+    gameState = PLAYING;
+    return true;
+}
+
+void Game::quickSaveOrLoad(bool load)
+{
+    if (!level) return;
+    if (level->isPlayingBack()) {
+        LOG_INFO(LogCategory::Game, "Checkpoints are disabled during a replay");
+        return;
+    }
+    if (level->isRecording()) {
+        LOG_INFO(LogCategory::Game, "Checkpoints are disabled while recording");
+        return;
+    }
+    if (!load) {
+        level->saveSnapshot(checkpoint);
+        LOG_INFO(LogCategory::Game, "Checkpoint saved at tick %d (%zu bytes)", level->getFrame(), checkpoint.size());
+    } else if (!checkpoint.empty()) {
+        level->restoreSnapshot(checkpoint);
+        LOG_INFO(LogCategory::Game, "Rewound to tick %d", level->getFrame());
+    }
+}
+
 void Game::update()
 {
     if (gameState == PLAYING && level) {
@@ -155,28 +227,47 @@ void Game::update()
     }
 }
 
-void Game::render()
+void Game::render(float alpha)
 {
+    PROFILE_SCOPE("Game::render");
     SDL_RenderClear(renderer);
     
     if (gameState == MENU) {
-        SDL_RenderTexture(renderer, menuBg, nullptr, nullptr);
-        SDL_RenderTexture(renderer, btnStart, nullptr, &startRect);
-        SDL_RenderTexture(renderer, btnManual, nullptr, &manualRect);
-        SDL_RenderTexture(renderer, btnQuit, nullptr, &quitRect);
+        SDL_RenderTexture(renderer, menuBg.get(), nullptr, nullptr);
+        SDL_RenderTexture(renderer, btnStart.get(), nullptr, &startRect);
+        SDL_RenderTexture(renderer, btnManual.get(), nullptr, &manualRect);
+        SDL_RenderTexture(renderer, btnQuit.get(), nullptr, &quitRect);
     } else if (gameState == PLAYING) {
-        if (level) level->render();
+        if (level) level->render(alpha);
     }
     
+#if ENABLE_PROFILER
+    if (showProfiler) Profiler::getInstance().drawOverlay(renderer, 8, 8);
+#endif
+    
+    PROFILE_SCOPE("Present");
     SDL_RenderPresent((renderer));
 }
 
 void Game::clean()
 {
-    SDL_DestroyTexture(menuBg);
-    SDL_DestroyTexture(btnStart);
-    SDL_DestroyTexture(btnManual);
-    SDL_DestroyTexture(btnQuit);
+    if (level && level->isRecording()) {
+        try {
+            level->stopRecording().save(recordPath.c_str());
+            LOG_INFO(LogCategory::Game, "Replay saved to %s", recordPath.c_str());
+        } catch (const ResourceError& e) {
+            LOG_ERROR(LogCategory::Resource, "%s", e.what());
+        }
+    }
+    
+    // Release every texture reference before the renderer goes away
+    delete level;
+    level = nullptr;
+    menuBg.reset();
+    btnStart.reset();
+    btnManual.reset();
+    btnQuit.reset();
+    TextureManager::Clear();
     
     SDL_DestroyWindow(window);
     SDL_DestroyRenderer(renderer);
@@ -184,7 +275,7 @@ void Game::clean()
     renderer = nullptr;
     isRunning = false;
     SDL_Quit();
-    Logger::getInstance().log("Game cleaned");
+    LOG_INFO(LogCategory::Game, "Game cleaned");
 
 }
 
@@ -1,14 +1,15 @@
 #include "GameObject.h"
 #include "TextureManager.h"
 #include "Logger.hpp"
-#include "Effect.h" // Full definition needed here
+#include "ByteStream.hpp"
+#include "CommandBuffer.hpp"
 #include <cstring>
 #include <sstream>
 
-int GameObject::objectCount = 0;
+std::atomic<int> GameObject::objectCount{0};
 
 int GameObject::getCount() {
-    return objectCount;
+    return objectCount.load(std::memory_order_relaxed);
 }
 
 //  Point2D
@@ -31,37 +32,28 @@ bool GameObject::checkCollision(const GameObject& a, const GameObject& b) {
 
 // GameObject
 GameObject::GameObject(const char* textureSheet, SDL_Renderer* ren, float x, float y)
-    : xPos(x), yPos(y), width(32), height(32), active(true), renderer(ren), texturePath(textureSheet ? textureSheet : "")
+    : xPos(x), yPos(y), prevX(x), prevY(y), width(32), height(32), active(true), renderer(ren),
+      texturePath(textureSheet ? textureSheet : "")
 {
-    objectCount++;
+    objectCount.fetch_add(1, std::memory_order_relaxed);
     if (renderer && !texturePath.empty()) {
         try {
-            objTexture = TextureManager::LoadTexture(textureSheet, ren);
+            objTexture = TextureManager::Acquire(textureSheet, ren);
         } catch (const ResourceError& e) {
-            Logger::getInstance().log(e.what());
-            // Fallback or rethrow?  
+            LOG_ERROR(LogCategory::Resource, "%s", e.what());
             // We can continue with null texture (invisible object) but log it.
             objTexture = nullptr; 
         }
-    } else {
-        objTexture = nullptr;
     }
 }
 
+// Textures are shared through the cache, so copies just add a reference
 GameObject::GameObject(const GameObject& other)
-    : xPos(other.xPos), yPos(other.yPos), width(other.width), height(other.height), 
-      active(other.active), renderer(other.renderer), texturePath(other.texturePath)
+    : xPos(other.xPos), yPos(other.yPos), prevX(other.prevX), prevY(other.prevY), width(other.width), height(other.height), 
+      active(other.active), renderer(other.renderer), texturePath(other.texturePath),
+      objTexture(other.objTexture), tint(other.tint)
 {
-    objectCount++;
-    if (renderer && !texturePath.empty()) {
-        try {
-            objTexture = TextureManager::LoadTexture(texturePath.c_str(), renderer);
-        } catch (...) {
-            objTexture = nullptr;
-        }
-    } else {
-        objTexture = nullptr;
-    }
+    objectCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 GameObject& GameObject::operator=(const GameObject& other) {
@@ -69,35 +61,30 @@ GameObject& GameObject::operator=(const GameObject& other) {
     
     xPos = other.xPos;
     yPos = other.yPos;
+    prevX = other.prevX;
+    prevY = other.prevY;
     width = other.width;
     height = other.height;
     active = other.active;
     renderer = other.renderer;
     texturePath = other.texturePath;
-    
-    if (objTexture) {
-        SDL_DestroyTexture(objTexture);
-        objTexture = nullptr;
-    }
-
-    if (renderer && !texturePath.empty()) {
-        try {
-            objTexture = TextureManager::LoadTexture(texturePath.c_str(), renderer);
-        } catch (...) {
-            objTexture = nullptr;
-        }
-    }
+    objTexture = other.objTexture;
+    tint = other.tint;
     
     return *this;
 }
 
-
-
 GameObject::~GameObject() {
-    objectCount--;
-    if (objTexture) {
-        SDL_DestroyTexture(objTexture);
-    }
+    objectCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void GameObject::drawTexture(SpriteBatch& batch, SpriteBatch::Layer layer, float alpha) const {
+    if (!objTexture) return;
+    Point2D p = getRenderPos(alpha);
+    SDL_FRect dst = destRect;
+    dst.x += p.getX() - xPos;
+    dst.y += p.getY() - yPos;
+    batch.draw(layer, objTexture.get(), &srcRect, dst, tint);
 }
 
 void GameObject::print(std::ostream& os) const {
@@ -114,6 +101,48 @@ void GameObject::onCollision(GameObject& /*other*/) {
     // Logger::log("Collision detected!");
 }
 
+namespace {
+
+void writeRect(ByteWriter& out, const SDL_FRect& r) {
+    out.f32(r.x);
+    out.f32(r.y);
+    out.f32(r.w);
+    out.f32(r.h);
+}
+
+void readRect(ByteReader& in, SDL_FRect& r) {
+    r.x = in.f32();
+    r.y = in.f32();
+    r.w = in.f32();
+    r.h = in.f32();
+}
+
+}
+
+void GameObject::saveState(ByteWriter& out) const {
+    out.f32(xPos);
+    out.f32(yPos);
+    out.f32(prevX);
+    out.f32(prevY);
+    out.sint(width);
+    out.sint(height);
+    out.boolean(active);
+    writeRect(out, srcRect);
+    writeRect(out, destRect);
+}
+
+void GameObject::loadState(ByteReader& in) {
+    xPos = in.f32();
+    yPos = in.f32();
+    prevX = in.f32();
+    prevY = in.f32();
+    width = in.sint();
+    height = in.sint();
+    active = in.boolean();
+    readRect(in, srcRect);
+    readRect(in, destRect);
+}
+
 // Enemy
 Enemy::Enemy(const char* name, Point2D startPos, int health, float speed, SDL_Renderer* ren)
     : GameObject("assets/enemy.bmp", ren, startPos.getX(), startPos.getY()),
@@ -123,12 +152,9 @@ Enemy::Enemy(const char* name, Point2D startPos, int health, float speed, SDL_Re
 // Deep Copy Constructor for Enemy
 Enemy::Enemy(const Enemy& other) 
     : GameObject(other), name(other.name), health(other.health), 
-      maxHealth(other.maxHealth), speed(other.speed), targetPos(other.targetPos)
+      maxHealth(other.maxHealth), speed(other.speed.getBase()), targetPos(other.targetPos)
 {
-    // Deep copy effects
-    for(const auto& eff : other.effects) {
-        effects.push_back(eff->clone());
-    }
+    // Effect records (and their speed modifiers) belong to the level and are not copied
 }
 
 std::unique_ptr<Enemy> Enemy::createGoblin(SDL_Renderer* ren, int x, int y) {
@@ -146,77 +172,48 @@ std::unique_ptr<GameObject> Enemy::clone() const {
 void Enemy::update() {
     if (!active) return;
     
-    // Move logic
+    move();
+    updateAfterMove();
+}
+
+void Enemy::move() {
     float dx = targetPos.getX() - xPos;
     float dy = targetPos.getY() - yPos;
     float dist = std::sqrt(dx*dx + dy*dy);
     
-    if (dist > speed) {
-        xPos += (dx/dist) * speed;
-        yPos += (dy/dist) * speed;
+    float step = speed.get();
+    if (dist > step) {
+        xPos += (dx/dist) * step;
+        yPos += (dy/dist) * step;
     }
-    
+}
+
+void Enemy::updateAfterMove() {
     // Update rects
     srcRect = {0, 0, 32, 32};
     destRect = {xPos, yPos, (float)width, (float)height};
-    
-    updateEffects();
-}
-
-void Enemy::addEffect(std::unique_ptr<Effect> effect) {
-    // Dynamic Cast Check: Do we already have this effect?
-    // If we have a SlowEffect, maybe don't add another?
-    // Or just push back.
-    // Let's demonstrate dynamic_cast usage:
-    bool exists = false;
-    for(const auto& eff : effects) {
-        if (effect->getName() == "Slow" && eff->getName() == "Slow") {
-            // Refresh?
-            exists = true; 
-        }
-    }
-    
-    if(!exists) {
-        effect->apply(this);
-        effects.push_back(std::move(effect));
-    }
 }
 
-void Enemy::updateEffects() {
-    for(auto& eff : effects) {
-        eff->update(this);
-    }
-    
-    std::erase_if(effects, [](const auto& eff){
-        return eff->isFinished();
-    });
-}
-
-void renderHealthBar(SDL_Renderer* ren, float x, float y, int hp, int maxHp) {
-    if (!ren) return;
+void renderHealthBar(SpriteBatch& batch, float x, float y, int hp, int maxHp) {
     SDL_FRect bgRect = {x, y - 10, 32.0f, 5.0f};
-    SDL_SetRenderDrawColor(ren, 255, 0, 0, 255);
-    SDL_RenderFillRect(ren, &bgRect);
+    batch.fillRect(SpriteBatch::Layer::Overlay, bgRect, {255, 0, 0, 255});
     
     float percentage = (float)hp / (float)maxHp;
     if (percentage < 0) percentage = 0;
     SDL_FRect fgRect = {x, y - 10, 32.0f * percentage, 5.0f};
-    SDL_SetRenderDrawColor(ren, 0, 255, 0, 255);
-    SDL_RenderFillRect(ren, &fgRect);
-    SDL_SetRenderDrawColor(ren, 255, 255, 255, 255);
+    batch.fillRect(SpriteBatch::Layer::Overlay, fgRect, {0, 255, 0, 255});
 }
 
-void Enemy::render() {
+void Enemy::render(SpriteBatch& batch, float alpha) {
     if (active) {
-        if (objTexture) SDL_RenderTexture(renderer, objTexture, &srcRect, &destRect);
-        renderHealthBar(renderer, xPos, yPos, health, maxHealth);
+        drawTexture(batch, SpriteBatch::Layer::Units, alpha);
+        Point2D p = getRenderPos(alpha);
+        renderHealthBar(batch, p.getX(), p.getY(), health, maxHealth);
     }
 }
 
 void Enemy::onClick() {
-    std::string message("Clicked on Enemy: ");
-    message += name;
-    Logger::getInstance().log(message);
+    LOG_INFO(LogCategory::Level, "Clicked on Enemy: %s", name.c_str());
 }
 
 void Enemy::setTarget(float x, float y) {
@@ -229,19 +226,35 @@ void Enemy::takeDamage(int amount) {
     if (health <= 0) {
         health = 0; 
         setActive(false); // Use setActive
-        std::string message("Enemy ");
-        message += name;
-        message += " defeated!";
-        Logger::getInstance().log(message);
+        LOG_DEBUG(LogCategory::Combat, "Enemy %s defeated!", name.c_str());
     }
 }
 
-void Enemy::print(std::ostream& os) const {
-    os << "Enemy [" << name << "] @" << getPos();
+void Enemy::saveState(ByteWriter& out) const {
+    GameObject::saveState(out);
+    out.str(name);
+    out.sint(health);
+    out.sint(maxHealth);
+    out.f32(speed.getBase());
+    out.f32(targetPos.getX());
+    out.f32(targetPos.getY());
 }
 
+void Enemy::loadState(ByteReader& in) {
+    GameObject::loadState(in);
+    in.str(name);
+    health = in.sint();
+    maxHealth = in.sint();
+    speed.clearModifiers(); // the level's effects re-add theirs
+    speed.setBase(in.f32());
+    float tx = in.f32();
+    targetPos = Point2D(tx, in.f32());
+    std::fill(std::begin(effectCounts), std::end(effectCounts), 0);
+}
 
-#define MAX_TOWERS 4
+void Enemy::print(std::ostream& os) const {
+    os << "Enemy [" << name << "] @" << getPos();
+}
 
 //  Tower
 Tower::Tower(Point2D pos, int damage, float range, SDL_Renderer* ren)
@@ -249,9 +262,7 @@ Tower::Tower(Point2D pos, int damage, float range, SDL_Renderer* ren)
       damage(damage), range(range), level(1), health(100)
 {
     // Default Visual: YELLOW
-    if (objTexture) {
-        SDL_SetTextureColorMod(objTexture, 255, 255, 0);
-    }
+    tint = {255, 255, 0, 255};
 }
 
 std::unique_ptr<GameObject> Tower::clone() const {
@@ -264,24 +275,25 @@ void Tower::update() {
     destRect = {xPos, yPos, (float)width, (float)height};
 }
 
-void Tower::render() {
-    if (objTexture) SDL_RenderTexture(renderer, objTexture, &srcRect, &destRect);
+void Tower::render(SpriteBatch& batch, float alpha) {
+    drawTexture(batch, SpriteBatch::Layer::Ground, alpha);
 }
 
 void Tower::takeDamage(int amount) {
+    if (!active) return;
     health -= amount;
-    if (health < 0) health = 0;
+    if (health <= 0) {
+        health = 0;
+        setActive(false); // the level removes it at the end of the tick
+        LOG_DEBUG(LogCategory::Combat, "Tower destroyed at (%.0f, %.0f)!", xPos, yPos);
+    }
 }
 
 void Tower::upgrade() {
     level++;
     damage += 5;
     range += 20.0f;
-    {
-        std::string message("Tower upgraded! Damage: ");
-        message += std::to_string(getDamage());
-        Logger::getInstance().log(message);
-    }
+    LOG_INFO(LogCategory::Level, "Tower upgraded! Damage: %d", getDamage());
 }
 
 bool Tower::canAttack(const Enemy& enemy) const {
@@ -289,13 +301,30 @@ bool Tower::canAttack(const Enemy& enemy) const {
     return getPos().distanceTo(enemy.getPos()) <= range;
 }
 
-void Tower::attack(Enemy& enemy) {
+void Tower::attack(Enemy& enemy, CommandBuffer& commands) {
     if (canAttack(enemy)) {
         enemy.takeDamage(damage);
+        if (!enemy.isActive()) commands.destroy(enemy);
         // Visual effect can be spawning a projectile here! implemented in Level.
     }
 }
 
+void Tower::saveState(ByteWriter& out) const {
+    GameObject::saveState(out);
+    out.sint(damage);
+    out.f32(range);
+    out.sint(level);
+    out.sint(health);
+}
+
+void Tower::loadState(ByteReader& in) {
+    GameObject::loadState(in);
+    damage = in.sint();
+    range = in.f32();
+    level = in.sint();
+    health = in.sint();
+}
+
 void Tower::print(std::ostream& os) const {
     os << "Tower [Lvl:" << level << "] @" << getPos();
 }
@@ -312,6 +341,14 @@ std::unique_ptr<GameObject> Projectile::clone() const {
     return std::make_unique<Projectile>(Point2D(xPos, yPos), target, speed, renderer, color);
 }
 
+void Projectile::launch(Point2D start, Point2D targetPos, SDL_Color col) {
+    setPos(start.getX(), start.getY());
+    storePreviousPos();
+    target = targetPos;
+    color = col;
+    active = true;
+}
+
 void Projectile::update() {
     if (!active) return;
     
@@ -334,16 +371,31 @@ void Projectile::update() {
     destRect = {xPos, yPos, 16.0f, 16.0f}; // Smaller
 }
 
-void Projectile::render() {
+void Projectile::render(SpriteBatch& batch, float alpha) {
     if (active) {
         // Render colored square/dot
-        SDL_FRect r = {xPos, yPos, 8, 8};
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        SDL_RenderFillRect(renderer, &r);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        Point2D p = getRenderPos(alpha);
+        SDL_FRect r = {p.getX(), p.getY(), 8, 8};
+        batch.fillRect(SpriteBatch::Layer::Effects, r, color);
     }
 }
 
+void Projectile::saveState(ByteWriter& out) const {
+    GameObject::saveState(out);
+    out.f32(speed);
+    out.f32(target.getX());
+    out.f32(target.getY());
+    out.bytes(&color, sizeof(color));
+}
+
+void Projectile::loadState(ByteReader& in) {
+    GameObject::loadState(in);
+    speed = in.f32();
+    float tx = in.f32();
+    target = Point2D(tx, in.f32());
+    in.bytes(&color, sizeof(color));
+}
+
 void Projectile::print(std::ostream& os) const {
     os << "Projectile @" << getPos();
 }
@@ -357,6 +409,13 @@ std::unique_ptr<GameObject> Explosion::clone() const {
     return std::make_unique<Explosion>(*this);
 }
 
+void Explosion::spawn(Point2D pos) {
+    setPos(pos.getX(), pos.getY());
+    storePreviousPos();
+    life = 10;
+    active = true;
+}
+
 void Explosion::update() {
     life--;
     if (life <= 0) active = false;
@@ -364,20 +423,28 @@ void Explosion::update() {
     destRect = {xPos, yPos, 32.0f, 32.0f};
 }
 
-void Explosion::render() {
+void Explosion::render(SpriteBatch& batch, float alpha) {
     if (active) {
         if (objTexture) {
-             SDL_RenderTexture(renderer, objTexture, &srcRect, &destRect);
+             drawTexture(batch, SpriteBatch::Layer::Effects, alpha);
         } else {
              // Fallback: Red square
              SDL_FRect r = {xPos, yPos, 32.0f, 32.0f};
-             SDL_SetRenderDrawColor(renderer, 255, 100, 0, 255); // Orange
-             SDL_RenderFillRect(renderer, &r);
-             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+             batch.fillRect(SpriteBatch::Layer::Effects, r, {255, 100, 0, 255}); // Orange
         }
     }
 }
 
+void Explosion::saveState(ByteWriter& out) const {
+    GameObject::saveState(out);
+    out.sint(life);
+}
+
+void Explosion::loadState(ByteReader& in) {
+    GameObject::loadState(in);
+    life = in.sint();
+}
+
 void Explosion::print(std::ostream& os) const {
     os << "Explosion @" << getPos();
 }
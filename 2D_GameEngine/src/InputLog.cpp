@@ -0,0 +1,141 @@
+#include "InputLog.hpp"
+#include "ByteStream.hpp"
+#include "GameObject.h"
+#include "Map.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+constexpr char MAGIC[4] = {'T', 'D', 'R', 'P'};
+
+constexpr uint64_t MAX_INPUTS = 1u << 24;
+
+// Ticks past this can't come from a real session; also keeps them in int
+constexpr uint64_t MAX_TICK = WaveSchedule::MAX_TICK;
+
+}
+
+void InputLog::record(const InputEvent& event) {
+    assert(events.empty() || event.tick >= events.back().tick);
+    events.push_back(event);
+}
+
+void InputLog::write(std::ostream& out) const {
+    std::vector<uint8_t> buffer;
+    encode(buffer);
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+}
+
+void InputLog::encode(std::vector<uint8_t>& buffer) const {
+    ByteWriter w(buffer);
+    w.bytes(MAGIC, sizeof(MAGIC));
+    w.varint(VERSION);
+    w.u64(seed);
+    w.varint(static_cast<uint32_t>(endTick));
+
+    Map::writeTiles(w, tiles);
+    WaveSchedule::write(w, waves);
+
+    w.varint(events.size());
+    int lastTick = 0;
+    for (const InputEvent& e : events) {
+        w.varint(static_cast<uint32_t>(e.tick - lastTick));
+        lastTick = e.tick;
+        w.byte(static_cast<uint8_t>(e.type));
+        switch (e.type) {
+            case InputType::Key:
+                w.varint(static_cast<uint32_t>(e.a));
+                break;
+            case InputType::Click:
+                w.f32(e.x);
+                w.f32(e.y);
+                break;
+            case InputType::Wheel:
+                w.f32(e.x);
+                w.f32(e.y);
+                w.f32(e.wheel);
+                break;
+            case InputType::SelectTower:
+                w.byte(static_cast<uint8_t>(e.a));
+                break;
+            case InputType::PlaceTower:
+                w.sint(e.a);
+                w.sint(e.b);
+                break;
+            case InputType::Count:
+                break;
+        }
+    }
+}
+
+void InputLog::save(const char* path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) throw ResourceError(std::string("Cannot write replay ") + path);
+    write(file);
+    if (!file) throw ResourceError(std::string("Failed writing replay ") + path);
+}
+
+InputLog InputLog::read(std::istream& in, const std::string& sourceName) {
+    std::vector<uint8_t> buffer{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    ByteReader r(buffer.data(), buffer.size(), sourceName.c_str());
+    char magic[sizeof(MAGIC)];
+    r.bytes(magic, sizeof(magic));
+    if (!std::equal(magic, magic + sizeof(MAGIC), MAGIC)) r.fail("not a replay file");
+    uint64_t version = r.varint();
+    if (version != VERSION) r.fail("unsupported replay version " + std::to_string(version));
+
+    InputLog log;
+    log.seed = r.u64();
+    uint64_t endTick = r.varint();
+    if (endTick > MAX_TICK) r.fail("end tick out of range");
+    log.endTick = static_cast<int>(endTick);
+
+    Map::readTiles(r, log.tiles);
+    log.waves = WaveSchedule::read(r);
+
+    log.events.resize(r.count(MAX_INPUTS, "inputs"));
+    int tick = 0;
+    for (InputEvent& e : log.events) {
+        uint64_t delta = r.varint();
+        if (delta > MAX_TICK - static_cast<uint64_t>(tick)) r.fail("input tick out of range");
+        tick += static_cast<int>(delta);
+        e.tick = tick;
+        uint8_t type = r.byte();
+        if (type >= static_cast<uint8_t>(InputType::Count)) r.fail("unknown input type");
+        e.type = static_cast<InputType>(type);
+        switch (e.type) {
+            case InputType::Key:
+                e.a = static_cast<int32_t>(r.varint());
+                break;
+            case InputType::Click:
+                e.x = r.f32();
+                e.y = r.f32();
+                break;
+            case InputType::Wheel:
+                e.x = r.f32();
+                e.y = r.f32();
+                e.wheel = r.f32();
+                break;
+            case InputType::SelectTower:
+                e.a = r.byte();
+                break;
+            case InputType::PlaceTower:
+                e.a = r.sint();
+                e.b = r.sint();
+                break;
+            case InputType::Count:
+                break;
+        }
+    }
+    return log;
+}
+
+InputLog InputLog::loadFile(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw ResourceError(std::string("Cannot open replay ") + path);
+    return read(file, path);
+}
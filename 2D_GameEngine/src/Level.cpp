@@ -1,72 +1,226 @@
 #include "Level.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
 #include "Utils.hpp"
 #include "EnemyFactory.h"
 #include "TowerFactory.h"
-#include "Matrix2D.hpp"
+#include "Grid2D.hpp"
+#include "ThreadPool.hpp"
 #include <sstream>
+#include <algorithm>
 
-#define MAX_TOWERS 4
+#define PROJECTILE_POOL_SIZE 64
+#define EXPLOSION_POOL_SIZE 64
+#define MAX_QUERY_CELLS 4096 // Target grids are rebuilt every tick; keep them small on big maps
+#define CAMERA_PAN_STEP 64.0f // screen pixels per key press
+#define CAMERA_ZOOM_STEP 1.25f
+#define CULL_MARGIN 16.0f // sprites are one tile; health bars sit above them
+#define AI_QUERY_CHUNK 256 // entities per parallel AI query task
 
-// Second instantiation of template class as requested (dummy usage)
-Matrix2D<float, 20, 25> dangerMap;
+namespace {
 
-Level::Level(SDL_Renderer* ren, int wave) 
+// Remove the entries at slots (any order, repeats allowed), keeping the
+// rest in order. Nothing before the first removed slot is touched; the
+// entries after it shift down and are told their new slot.
+template <typename T>
+bool removeSlots(std::vector<std::unique_ptr<T>>& list, std::vector<int>& slots) {
+    if (slots.empty()) return false;
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    size_t out = static_cast<size_t>(slots.front());
+    size_t next = 0;
+    for (size_t i = out; i < list.size(); i++) {
+        if (next < slots.size() && static_cast<size_t>(slots[next]) == i) {
+            next++;
+            continue;
+        }
+        list[i]->setSlot(static_cast<int>(out));
+        list[out++] = std::move(list[i]);
+    }
+    list.resize(out);
+    return true;
+}
+
+}
+
+Level::Level(SDL_Renderer* ren, int wave, uint64_t seed) 
     : cursorX(12), cursorY(10), towersPlaced(0), gameTimerFrames(0), gameOver(false), gameWon(false), 
-      renderer(ren), map(nullptr), currentWave(wave), frameCount(0), spawnTimer(0) 
+      renderer(ren), logger(&Logger::getInstance()), map(nullptr), currentWave(wave), frameCount(0),
+      seed(seed), rng(seed),
+      enemyGrid(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE),
+      towerGrid(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE),
+      flowField(Map::DEFAULT_COLS, Map::DEFAULT_ROWS, Map::TILE_SIZE),
+      projectiles(PROJECTILE_POOL_SIZE, Projectile(Point2D(), Point2D(), 10.0f, ren, SDL_Color{0, 0, 0, 255})),
+      explosions(EXPLOSION_POOL_SIZE, Explosion(Point2D(), ren)),
+      spareProjectiles(projectiles), spareExplosions(explosions),
+      batch(ren)
 {
     map = new Map(ren);
+    camera.setWorldSize(static_cast<float>(map->getPixelWidth()), static_cast<float>(map->getPixelHeight()));
+    compileWaves({WaveSchedule::defaultWave(20 * TICKS_PER_SECOND, 60 * TICKS_PER_SECOND)});
     // Polymorphic load could go here
 }
 
 Level::~Level() {
     delete map;
-    // objects cleared automatically by unique_ptr
+    // collections cleared automatically by unique_ptr
 }
 
-void Level::loadMap(int arr[20][25]) {
-    map->LoadMap(arr);
+void Level::loadMap(const Grid2D<int>& tiles) {
+    Logger::Scope logScope(logger);
+    bool resized = tiles.getRows() != map->getRows() || tiles.getCols() != map->getCols();
+    map->LoadMap(tiles);
+    flowFieldDirty = true;
+    camera.setWorldSize(static_cast<float>(map->getPixelWidth()), static_cast<float>(map->getPixelHeight()));
+    if (!resized) return;
+
+    // Everything sized by the map follows it. Query cells grow by powers of
+    // two so a rebuild never sweeps more than MAX_QUERY_CELLS buckets.
+    int cellTiles = 1;
+    int gridCols = map->getCols();
+    int gridRows = map->getRows();
+    while (gridCols * gridRows > MAX_QUERY_CELLS) {
+        cellTiles *= 2;
+        gridCols = (map->getCols() + cellTiles - 1) / cellTiles;
+        gridRows = (map->getRows() + cellTiles - 1) / cellTiles;
+    }
+    enemyGrid = SpatialGrid<Enemy>(gridCols, gridRows, static_cast<float>(cellTiles * Map::TILE_SIZE));
+    towerGrid = SpatialGrid<Tower>(gridCols, gridRows, static_cast<float>(cellTiles * Map::TILE_SIZE));
+    cursorX = std::min(cursorX, map->getCols() - 1);
+    cursorY = std::min(cursorY, map->getRows() - 1);
+    compileWaves(waveDefs); // Spawn edges moved
+    LOG_INFO(LogCategory::Level, "Map resized to %dx%d tiles", map->getCols(), map->getRows());
 }
 
-// Helper to filter objects by type
-// Using IDamageable interface check where appropriate would be better design, but for specific list access:
-std::vector<Enemy*> Level::getEnemies() {
-    std::vector<Enemy*> enemies;
-    for(auto& obj : objects) {
-        // Safe check using dynamic_cast as requested for meaningful RTTI
-        if(auto e = dynamic_cast<Enemy*>(obj.get())) {
-            if(e->isActive()) enemies.push_back(e);
-        }
+void Level::onRenderTargetsReset(bool deviceLost) {
+    if (deviceLost) map->resetTileLayer();
+    else map->invalidate();
+}
+
+void Level::loadDefaultMap(int cols, int rows) {
+    loadMap(Map::defaultTiles(cols, rows));
+}
+
+Point2D Level::getMapCenter() const {
+    return Point2D(map->getPixelWidth() / 2.0f, map->getPixelHeight() / 2.0f);
+}
+
+void Level::addTower(std::unique_ptr<Tower> tower) {
+    Logger::Scope logScope(logger);
+    adopt(std::move(tower));
+}
+
+void Level::spawnEnemy(std::unique_ptr<Enemy> enemy) {
+    adopt(std::move(enemy));
+}
+
+void Level::adopt(std::unique_ptr<Enemy> enemy) {
+    enemy->setSlot(static_cast<int>(enemies.size()));
+    enemies.push_back(std::move(enemy));
+}
+
+void Level::adopt(std::unique_ptr<Tower> tower) {
+    tower->setSlot(static_cast<int>(towers.size()));
+    towers.push_back(std::move(tower));
+    onTowerAdded(*towers.back());
+}
+
+void Level::commit() {
+    for (const CommandBuffer::EffectCommand& c : commands.effects) {
+        if (c.type == EffectType::Slow) statusEffects.addSlow(*c.target, c.ticks, c.factor);
+        else statusEffects.addBurn(*c.target, c.ticks, c.damage);
     }
-    return enemies;
+    if (removeSlots(towers, commands.towerDestroys)) flowFieldDirty = true; // goals only shrink on rebuild
+    if (!commands.enemyDestroys.empty()) {
+        statusEffects.removeInactive(); // records point at enemies about to be freed
+        removeSlots(enemies, commands.enemyDestroys);
+    }
+    for (auto& e : commands.enemySpawns) adopt(std::move(e));
+    for (auto& t : commands.towerSpawns) adopt(std::move(t));
+    commands.clear();
 }
 
-std::vector<Tower*> Level::getTowers() {
-    std::vector<Tower*> towers;
-    for(auto& obj : objects) {
-        if(auto t = dynamic_cast<Tower*>(obj.get())) {
-            if(t->isActive()) towers.push_back(t);
-        }
+int Level::flowTileOf(const GameObject& obj) const {
+    // Tile under the sprite's centre
+    return flowField.tileAt(obj.getX() + Map::TILE_SIZE / 2.0f, obj.getY() + Map::TILE_SIZE / 2.0f);
+}
+
+void Level::onTowerAdded(const Tower& tower) {
+    if (flowFieldDirty || !flowGoalsAreTowers) {
+        // The field still leads to the centre: it has to be replaced, not extended
+        flowFieldDirty = true;
+        return;
     }
-    return towers;
+    flowField.addGoal(flowTileOf(tower));
 }
 
-void Level::placeTower(int x, int y) {
-    // Grid coords are internal logic
-    int col = x; 
-    int row = y;
-    
-    // Pixel/Grid conversion
-    if (x > 25 && y > 25) { 
-        col = x / 32;
-        row = y / 32;
+void Level::rebuildFlowField() {
+    std::vector<int> goals;
+    goals.reserve(towers.size());
+    for (const auto& t : towers) {
+        if (t->isActive()) goals.push_back(flowTileOf(*t));
+    }
+    flowGoalsAreTowers = !goals.empty();
+    if (goals.empty()) {
+        Point2D center = getMapCenter(); // Default to center if no towers
+        goals.push_back(flowField.tileAt(center.getX(), center.getY()));
+    }
+    flowField.rebuild(*map, goals);
+    flowFieldDirty = false;
+    LOG_DEBUG(LogCategory::Level, "Flow field rebuilt (%zu goals, rebuild #%d)", goals.size(), flowField.getRebuildCount());
+}
+
+void Level::compileWaves(const std::vector<WaveDef>& waves) {
+    // Reseed so the timeline depends only on the seed and the wave list
+    waveDefs = waves;
+    rng.seed(seed);
+    spawnSchedule.compile(waves, rng, map->getPixelWidth(), map->getPixelHeight());
+}
+
+void Level::setWaves(const std::vector<WaveDef>& waves) {
+    compileWaves(waves);
+}
+
+bool Level::loadWaves(const char* path) {
+    Logger::Scope logScope(logger);
+    try {
+        std::vector<WaveDef> waves = WaveSchedule::loadFile(path);
+        compileWaves(waves);
+        LOG_INFO(LogCategory::Level, "Loaded %zu waves from %s (%zu spawns)", waves.size(), path, spawnSchedule.size());
+        return true;
+    } catch (const ResourceError& e) {
+        LOG_WARN(LogCategory::Resource, "%s. Using the built-in wave.", e.what());
+        return false;
     }
+}
 
+void Level::placeTower(int x, int y) {
+    Logger::Scope logScope(logger);
+    InputEvent input;
+    input.type = InputType::PlaceTower;
+    input.a = x;
+    input.b = y;
+    if (takeInput(input)) placeTowerAt(x, y);
+}
 
+void Level::selectTowerType(TowerType type) {
+    InputEvent input;
+    input.type = InputType::SelectTower;
+    input.a = static_cast<int32_t>(type);
+    if (takeInput(input)) selectedTowerType = type;
+}
+
+void Level::placeTowerAt(int col, int row) {
+    // Grid coords are internal logic
+    if (col < 0 || col >= map->getCols() || row < 0 || row >= map->getRows()) {
+        LOG_WARN(LogCategory::Level, "Tower at grid (%d, %d) is outside the %dx%d map.", col, row,
+                 map->getCols(), map->getRows());
+        return;
+    }
 
     // Logic: Only allow placement during Prep Phase
-    if (gameTimerFrames >= 20 * 30) {
-        Logger::getInstance().log("Prep Phase Over! Cannot place towers.");
+    if (gameTimerFrames >= 20 * TICKS_PER_SECOND) {
+        LOG_INFO(LogCategory::Level, "Prep Phase Over! Cannot place towers.");
         return;
     }
     
@@ -76,53 +230,78 @@ void Level::placeTower(int x, int y) {
         // Use Factory with selected type
         float tx = col * 32.0f;
         float ty = row * 32.0f;
-        auto t = TowerFactory::createTower(selectedTowerType, Point2D(tx, ty), renderer);
-        objects.push_back(std::move(t));
+        adopt(TowerFactory::createTower(selectedTowerType, Point2D(tx, ty), renderer));
         
-        std::stringstream ss;
-        ss << "Placed tower at grid (" << col << ", " << row << "). Count: " << towersPlaced << "/" << MAX_TOWERS;
-        Logger::getInstance().log(ss.str());
+        LOG_INFO(LogCategory::Level, "Placed tower at grid (%d, %d). Count: %d/%d", col, row, towersPlaced, MAX_TOWERS);
     } else {
-        std::stringstream ss;
-        ss << "Max towers reached! (" << towersPlaced << "/" << MAX_TOWERS << ")";
-        Logger::getInstance().log(ss.str());
+        LOG_INFO(LogCategory::Level, "Max towers reached! (%d/%d)", towersPlaced, MAX_TOWERS);
     }
 }
 
 void Level::handleInput(SDL_Keycode key) {
+    Logger::Scope logScope(logger);
+    InputEvent input;
+    input.type = InputType::Key;
+    input.a = static_cast<int32_t>(key);
+    if (!takeInput(input)) return;
     if (gameOver) return;
     
     switch (key) {
         case SDLK_UP:
             if (cursorY > 0) cursorY--;
+            followCursor();
             break;
         case SDLK_DOWN:
-            if (cursorY < 19) cursorY++;
+            if (cursorY < map->getRows() - 1) cursorY++;
+            followCursor();
             break;
         case SDLK_LEFT:
             if (cursorX > 0) cursorX--;
+            followCursor();
             break;
         case SDLK_RIGHT:
-            if (cursorX < 24) cursorX++;
+            if (cursorX < map->getCols() - 1) cursorX++;
+            followCursor();
             break;
         case SDLK_RETURN:
-            placeTower(cursorX, cursorY);
+            placeTowerAt(cursorX, cursorY);
+            break;
+        case SDLK_W:
+            camera.pan(0.0f, -CAMERA_PAN_STEP);
+            break;
+        case SDLK_S:
+            camera.pan(0.0f, CAMERA_PAN_STEP);
+            break;
+        case SDLK_A:
+            camera.pan(-CAMERA_PAN_STEP, 0.0f);
+            break;
+        case SDLK_D:
+            camera.pan(CAMERA_PAN_STEP, 0.0f);
+            break;
+        case SDLK_EQUALS:
+        case SDLK_KP_PLUS:
+            camera.zoomBy(CAMERA_ZOOM_STEP, camera.getViewportWidth() / 2, camera.getViewportHeight() / 2);
+            break;
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS:
+            camera.zoomBy(1.0f / CAMERA_ZOOM_STEP, camera.getViewportWidth() / 2, camera.getViewportHeight() / 2);
             break;
         case SDLK_1:
             selectedTowerType = TowerType::Basic;
-            Logger::getInstance().log("Selected: Basic Tower");
+            LOG_INFO(LogCategory::Level, "Selected: Basic Tower");
             break;
         case SDLK_2:
             selectedTowerType = TowerType::Ice;
-            Logger::getInstance().log("Selected: Ice Tower");
+            LOG_INFO(LogCategory::Level, "Selected: Ice Tower");
             break;
         case SDLK_3:
             selectedTowerType = TowerType::Fire;
-            Logger::getInstance().log("Selected: Fire Tower");
+            LOG_INFO(LogCategory::Level, "Selected: Fire Tower");
             break;
         case SDLK_U:
             // Upgrade tower at cursor
-            for(auto* t : getTowers()) {
+            for(auto& t : towers) {
+                if (!t->isActive()) continue;
                 // Check if cursor roughly over tower (grid check)
                 int tx = (int)t->getX() / 32;
                 int ty = (int)t->getY() / 32;
@@ -135,189 +314,400 @@ void Level::handleInput(SDL_Keycode key) {
 }
 
 void Level::handleMouseClick(int x, int y) {
+    Logger::Scope logScope(logger);
+    // Recorded in world coordinates, so a replay doesn't depend on the camera
+    SDL_FPoint world = camera.toWorld(static_cast<float>(x), static_cast<float>(y));
+    InputEvent input;
+    input.type = InputType::Click;
+    input.x = world.x;
+    input.y = world.y;
+    if (takeInput(input)) clickAt(world);
+}
+
+void Level::clickAt(SDL_FPoint world) {
     if (gameOver) return;
     
     // Check click on Enemies
-    for(auto* e : getEnemies()) {
-        if (x >= e->getX() && x <= e->getX() + 32 &&
-            y >= e->getY() && y <= e->getY() + 32) {
+    for(auto& e : enemies) {
+        if (!e->isActive()) continue;
+        if (world.x >= e->getX() && world.x <= e->getX() + 32 &&
+            world.y >= e->getY() && world.y <= e->getY() + 32) {
             e->onClick();
         }
     }
 }
 
+void Level::handleMouseWheel(float x, float y, float wheel) {
+    InputEvent input;
+    input.type = InputType::Wheel;
+    input.x = x;
+    input.y = y;
+    input.wheel = wheel;
+    if (!takeInput(input)) return;
+    if (wheel == 0.0f) return;
+    camera.zoomBy(wheel > 0.0f ? CAMERA_ZOOM_STEP : 1.0f / CAMERA_ZOOM_STEP, x, y);
+}
+
+bool Level::isFresh() const {
+    return gameTimerFrames == 0 && towers.empty() && enemies.empty();
+}
+
+bool Level::takeInput(const InputEvent& input) {
+    if (playback && !applyingPlayback) return false; // the replay owns the level
+    if (recording) {
+        InputEvent stamped = input;
+        stamped.tick = gameTimerFrames;
+        recording->record(stamped);
+    }
+    return true;
+}
+
+void Level::applyInput(const InputEvent& input) {
+    switch (input.type) {
+        case InputType::Key:
+            handleInput(static_cast<SDL_Keycode>(input.a));
+            break;
+        case InputType::Click:
+            clickAt({input.x, input.y});
+            break;
+        case InputType::Wheel:
+            handleMouseWheel(input.x, input.y, input.wheel);
+            break;
+        case InputType::SelectTower:
+            selectTowerType(static_cast<TowerType>(input.a));
+            break;
+        case InputType::PlaceTower:
+            placeTower(input.a, input.b);
+            break;
+        case InputType::Count:
+            break;
+    }
+}
+
+bool Level::startRecording() {
+    Logger::Scope logScope(logger);
+    if (!isFresh() || playback) {
+        LOG_WARN(LogCategory::Level, "Recording must start before the first tick.");
+        return false;
+    }
+    recording = std::make_unique<InputLog>(seed, map->getTiles(), waveDefs);
+    LOG_INFO(LogCategory::Level, "Recording inputs (seed %llu)", static_cast<unsigned long long>(seed));
+    return true;
+}
+
+InputLog Level::stopRecording() {
+    Logger::Scope logScope(logger);
+    if (!recording) throw LogicError("stopRecording() without startRecording()");
+    InputLog log = std::move(*recording);
+    recording.reset();
+    log.setEndTick(gameTimerFrames);
+    LOG_INFO(LogCategory::Level, "Recorded %zu inputs over %d ticks", log.size(), log.getEndTick());
+    return log;
+}
+
+bool Level::startPlayback(InputLog log) {
+    Logger::Scope logScope(logger);
+    if (!isFresh() || recording) {
+        LOG_WARN(LogCategory::Level, "Playback must start before the first tick.");
+        return false;
+    }
+    seed = log.getSeed();
+    loadMap(log.getTiles());
+    compileWaves(log.getWaves()); // reseeds from the recorded seed
+    log.rewind();
+    playback = std::make_unique<InputLog>(std::move(log));
+    LOG_INFO(LogCategory::Level, "Replaying %zu inputs over %d ticks (seed %llu)", playback->size(),
+             playback->getEndTick(), static_cast<unsigned long long>(seed));
+    return true;
+}
+
+template <typename Fn>
+void Level::forChunks(size_t count, Fn&& body) {
+    if (pool) pool->parallelFor(count, AI_QUERY_CHUNK, body);
+    else body(size_t{0}, count);
+}
+
+void Level::followCursor() {
+    camera.ensureVisible({cursorX * static_cast<float>(Map::TILE_SIZE), cursorY * static_cast<float>(Map::TILE_SIZE),
+                          static_cast<float>(Map::TILE_SIZE), static_cast<float>(Map::TILE_SIZE)});
+}
+
 void Level::update() {
+    PROFILE_SCOPE("Level::update");
+    Logger::Scope logScope(logger);
+    if (playback) {
+        // Inputs that arrived after the previous tick, as they did when recorded
+        applyingPlayback = true;
+        playback->consume(gameTimerFrames, [this](const InputEvent& input) { applyInput(input); });
+        applyingPlayback = false;
+    }
+
+    // Interpolation starts from where everything is now; once the level is
+    // over this pins previous to current, so render(alpha) holds still
+    for(auto& t : towers) t->storePreviousPos();
+    for(auto& e : enemies) e->storePreviousPos();
+    projectiles.forEach([](Projectile& p) { p.storePreviousPos(); });
+    explosions.forEach([](Explosion& x) { x.storePreviousPos(); });
     if (gameOver) return;
 
     // Timer
     gameTimerFrames++;
-    if (gameTimerFrames >= 30 * 60) { 
+    if (gameTimerFrames >= TICKS_PER_SECOND * 60) { 
         gameOver = true;
         gameWon = true; 
-        Logger::getInstance().log("Time is up! You survived!");
+        LOG_INFO(LogCategory::Level, "Time is up! You survived!");
     }
 
-    //  Prep Phase (20 seconds)
-    if (gameTimerFrames < 20 * 30) {
-        if (gameTimerFrames % 30 == 0) {
-            std::stringstream ss;
-            ss << "Prep Phase: " << (20 - gameTimerFrames/30) << "s remaining. Place towers!";
-            Logger::getInstance().log(ss.str());
+    //  Prep Phase (20 seconds), then the precomputed spawns due this tick
+    {
+        PROFILE_SCOPE("Update/Spawn");
+        if (gameTimerFrames < 20 * TICKS_PER_SECOND && gameTimerFrames % TICKS_PER_SECOND == 0) {
+            LOG_DEBUG(LogCategory::Level, "Prep Phase: %ds remaining. Place towers!",
+                      20 - gameTimerFrames / TICKS_PER_SECOND);
         }
-    } else {
-        // Spawn Logic
-        spawnTimer++;
-        // Use Utils::MathUtils::clamp to ensure spawnTimer doesn't exceed limit
-        spawnTimer = (int)Utils::MathUtils::clamp((float)spawnTimer, 0.0f, 150.0f);
-        
-        if (spawnTimer >= 150) {
-            int side = rand() % 4;
-            int sx = 0;
-            int sy = 0;
-            switch(side) {
-                case 0: sx = rand() % 800; sy = 0; break; 
-                case 1: sx = rand() % 800; sy = 600; break; 
-                case 2: sx = 0; sy = rand() % 600; break; 
-                case 3: sx = 800; sy = rand() % 600; break; 
-            }
-            
-            // Polymorphic Add: Enemy using Factory Pattern
+
+        spawnSchedule.consume(gameTimerFrames, [this](const SpawnEvent& s) {
+            // Enemy using Factory Pattern
             std::unique_ptr<Enemy> e;
-            if (rand() % 2 == 0) {
-                 e = EnemyFactory::createGoblin(renderer, sx, sy);
+            if (s.kind == EnemyKind::Goblin) {
+                 e = EnemyFactory::createGoblin(renderer, s.x, s.y);
             } else {
-                 e = EnemyFactory::createOrc(renderer, sx, sy);
+                 e = EnemyFactory::createOrc(renderer, s.x, s.y);
             }
 
-            e->setTarget(400, 300); // Default Center
-            objects.push_back(std::move(e));
-            
-            spawnTimer = 0;
-        }
+            Point2D center = getMapCenter(); // Default Center
+            e->setTarget(center.getX(), center.getY());
+            commands.spawn(std::move(e));
+        });
+        commit();
     }
-    
-    // Polymorphic Update
-    // Iterate and update all objects (Towers, Enemies, Projectiles)
-    for(auto& obj : objects) {
-        obj->update();
+
+    // Update each collection; no filtering or casts needed
+    {
+        PROFILE_SCOPE("Update/Objects");
+        for(auto& t : towers) t->update();
+        // Enemies move in one SoA batch, then do their per-object work
+        enemyMotion.load(enemies);
+        enemyMotion.step();
+        enemyMotion.store();
+        for(auto& e : enemies) {
+            if (e->isActive()) e->updateAfterMove();
+        }
+        damageDealt += statusEffects.update(commands);
+        projectiles.forEach([](Projectile& p) { p.update(); });
+        explosions.forEach([](Explosion& x) { x.update(); });
     }
-    
+
     // Logic / AI Update
-    // We need to fetch filtered lists to interact
-    auto enemies = getEnemies();
-    auto towers = getTowers();
-    
-    // 1. Enemy AI: Target Towers (Using template function findNearest)
-    for(auto* enemy : enemies) {
-        // Find nearest Tower to attack
-        // Instantiation 1 of template function
-        Tower* targetTower = Utils::findNearest<Tower>(*enemy, objects, 99999.0f);
-        
-        if (targetTower) {
-            enemy->setTarget(targetTower->getX(), targetTower->getY());
-        } else {
-            enemy->setTarget(400, 300); // Default to center if no towers
+    {
+        PROFILE_SCOPE("Update/Grids");
+        enemyGrid.rebuild(enemies);
+        towerGrid.rebuild(towers);
+        if (flowFieldDirty || flowField.getMapRevision() != map->getRevision()) {
+            rebuildFlowField();
         }
-        
-        // Terrain Speed
-        int r = (int)enemy->getY() / 32;
-        if (r == 10) enemy->setSpeed(1.0f);
-        else enemy->setSpeed(2.5f);
-        
-        // Attack Tower if close
-        if (targetTower) {
-             // Use checkCollision static method
-             if (GameObject::checkCollision(*enemy, *targetTower)) {
-                 // Meaningful cast for logic
-                 IDamageable* dmgObj = dynamic_cast<IDamageable*>(targetTower);
-                 if (dmgObj && frameCount == 0) {
-                     dmgObj->takeDamage(1); 
+    }
+
+    // 1. Enemy AI: Target Towers
+    {
+        PROFILE_SCOPE("Update/EnemyAI");
+        // Query pass (read-only, parallel): nearest tower and flow step per enemy
+        enemyQueries.resize(enemies.size());
+        forChunks(enemies.size(), [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Enemy& enemy = *enemies[i];
+                if (!enemy.isActive()) continue;
+                EnemyQuery& q = enemyQueries[i];
+                q.target = towerGrid.findNearest(enemy, 99999.0f);
+                q.tile = flowTileOf(enemy);
+                q.next = flowField.nextTile(q.tile);
+            }
+        });
+
+        // Apply pass, in order
+        for (size_t i = 0; i < enemies.size(); i++) {
+            Enemy* enemy = enemies[i].get();
+            if (!enemy->isActive()) continue;
+            const EnemyQuery& q = enemyQueries[i];
+            // Find nearest Tower to attack. Only a tower destroyed earlier in this
+            // pass can make the answer stale; then ask again among the rest.
+            Tower* targetTower = q.target;
+            if (targetTower && !targetTower->isActive()) targetTower = towerGrid.findNearest(*enemy, 99999.0f);
+
+            // Walk the flow field one tile at a time; head straight in once on a goal tile
+            if (q.next != q.tile) {
+                enemy->setTarget(flowField.getCol(q.next) * (float)Map::TILE_SIZE,
+                                 flowField.getRow(q.next) * (float)Map::TILE_SIZE);
+            } else if (targetTower) {
+                enemy->setTarget(targetTower->getX(), targetTower->getY());
+            } else {
+                Point2D center = getMapCenter(); // Default to center if no towers
+                enemy->setTarget(center.getX(), center.getY());
+            }
+
+            // Terrain Speed (slows stay on top as modifiers; recomputed only if the tile type changed)
+            enemy->setBaseSpeed(Map::getTileSpeed(map->getTile(flowField.getRow(q.tile), flowField.getCol(q.tile))));
+
+            // Attack Tower if close
+            if (targetTower) {
+                 // Use checkCollision static method
+                 if (GameObject::checkCollision(*enemy, *targetTower)) {
+                     // Meaningful cast for logic
+                     IDamageable* dmgObj = dynamic_cast<IDamageable*>(targetTower);
+                     if (dmgObj && frameCount == 0) {
+                         dmgObj->takeDamage(1); 
+                         if (!targetTower->isActive()) commands.destroy(*targetTower);
+                     }
                  }
-             }
+            }
         }
     }
-    
+
     // 2. Tower AI: Attack Enemies
-    frameCount++;
-    if (frameCount >= 30) { 
-        for(auto* tower : towers) {
-            // Instantiation 2 of template function
-            Enemy* nearestEnemy = Utils::findNearest<Enemy>(*tower, objects, tower->getRange());
-            
-            if (nearestEnemy && tower->canAttack(*nearestEnemy)) {
-                tower->attack(*nearestEnemy);
-                // Spawn Projectile (Visual)
-                Point2D startP = tower->getPos();
-                Point2D endP = nearestEnemy->getPos();
-                    
-                    // Use static distance helper
-                    // float d = GameObject::distance(*tower, *enemy);
-                    
-                // Use Utils::MathUtils::lerp to... calculate a slightly offset start (dummy usage but logical)
-                float lx = Utils::MathUtils::lerp(startP.getX(), endP.getX(), 0.1f);
-                float ly = Utils::MathUtils::lerp(startP.getY(), endP.getY(), 0.1f);
-                Point2D lerpStart(lx, ly);
-                
-                // Use Utils::MathUtils::angleBetween (log it)
-                double angle = Utils::MathUtils::angleBetween(lx, ly, endP.getX(), endP.getY());
-                {
-                    std::string message("Shot angle: ");
-                    message += std::to_string(angle);
-                    Logger::getInstance().log(message);
+    {
+        PROFILE_SCOPE("Update/TowerAI");
+        frameCount++;
+        if (frameCount >= TICKS_PER_SECOND) { // one volley per second
+            // Query pass (read-only, parallel): nearest enemy in range per tower
+            towerQueries.resize(towers.size());
+            forChunks(towers.size(), [this](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const Tower& tower = *towers[i];
+                    towerQueries[i] = tower.isActive() ? enemyGrid.findNearest(tower, tower.getRange()) : nullptr;
                 }
+            });
+
+            // Apply pass, in order: damage, effects and visuals
+            for (size_t i = 0; i < towers.size(); i++) {
+                Tower* tower = towers[i].get();
+                if (!tower->isActive()) continue;
+                Enemy* nearestEnemy = towerQueries[i];
+                // Killed by an earlier tower this volley: the next nearest in range instead
+                if (nearestEnemy && !nearestEnemy->isActive()) nearestEnemy = enemyGrid.findNearest(*tower, tower->getRange());
+
+                if (nearestEnemy && tower->canAttack(*nearestEnemy)) {
+                    int healthBefore = nearestEnemy->getHealth();
+                    tower->attack(*nearestEnemy, commands);
+                    damageDealt += healthBefore - nearestEnemy->getHealth();
+                    // Spawn Projectile (Visual)
+                    Point2D startP = tower->getPos();
+                    Point2D endP = nearestEnemy->getPos();
+
+                        // Use static distance helper
+                        // float d = GameObject::distance(*tower, *enemy);
+
+                    // Use Utils::MathUtils::lerp to... calculate a slightly offset start (dummy usage but logical)
+                    float lx = Utils::MathUtils::lerp(startP.getX(), endP.getX(), 0.1f);
+                    float ly = Utils::MathUtils::lerp(startP.getY(), endP.getY(), 0.1f);
+                    Point2D lerpStart(lx, ly);
+
+                    // Use Utils::MathUtils::angleBetween (log it; compiled out below Trace)
+                    LOG_TRACE(LogCategory::Combat, "Shot angle: %f",
+                              Utils::MathUtils::angleBetween(lx, ly, endP.getX(), endP.getY()));
 
-                objects.push_back(std::unique_ptr<GameObject>(
-                    new Projectile(lerpStart, endP, 10.0f, renderer, tower->getProjectileColor())
-                ));
-                // Add Explosion (Muzzle Flash)
-                objects.push_back(std::unique_ptr<GameObject>(
-                    new Explosion(startP, renderer)
-                ));
+                    // Pooled visuals; when a pool is exhausted the shot still lands, just unseen
+                    if (Projectile* p = projectiles.acquire()) {
+                        p->launch(lerpStart, endP, tower->getProjectileColor());
+                    }
+                    // Add Explosion (Muzzle Flash)
+                    if (Explosion* x = explosions.acquire()) {
+                        x->spawn(startP);
+                    }
+                }
             }
+            frameCount = 0;
         }
-        frameCount = 0;
     }
 
-    // Cleanup Dead Object
-    // Custom predicate dealing with unique_ptr
-    std::erase_if(objects, [](const auto& obj){ 
-        return !obj->isActive(); // Assuming base GameObject has isActive
-        
-    });
-    
+    // Cleanup Dead Objects: the kills and effects recorded this tick
+    bool lastTowerFell = false;
+    {
+        PROFILE_SCOPE("Update/Cleanup");
+        bool hadTowers = !towers.empty();
+        commit();
+        lastTowerFell = hadTowers && towers.empty();
+        projectiles.releaseInactive();
+        explosions.releaseInactive();
+    }
+
+    // The base is the towers: once the last one falls, the level is lost
+    if (lastTowerFell && !gameOver) {
+        gameOver = true;
+        gameWon = false;
+        LOG_INFO(LogCategory::Level, "All towers destroyed! You lost.");
+    }
+
     // Update Title
-    SDL_Window* win = SDL_GetRenderWindow(renderer);
-    if (win) {
-        std::stringstream titleSS;
-        int seconds = gameTimerFrames / 30;
-        int prepLeft = 20 - seconds;
-        if (prepLeft > 0) titleSS << "Tower Defense - PREP: " << prepLeft << "s";
-        else titleSS << "Tower Defense - SURVIVE: " << (seconds - 20) << "s";
-        SDL_SetWindowTitle(win, titleSS.str().c_str());
+    {
+        PROFILE_SCOPE("Update/Title");
+        SDL_Window* win = renderer ? SDL_GetRenderWindow(renderer) : nullptr;
+        if (win) {
+            std::stringstream titleSS;
+            int seconds = gameTimerFrames / TICKS_PER_SECOND;
+            int prepLeft = 20 - seconds;
+            if (prepLeft > 0) titleSS << "Tower Defense - PREP: " << prepLeft << "s";
+            else titleSS << "Tower Defense - SURVIVE: " << (seconds - 20) << "s";
+            SDL_SetWindowTitle(win, titleSS.str().c_str());
+        }
     }
 }
 
-void Level::render() {
-    map->DrawMap();
+void Level::render(float alpha) {
+    if (!renderer) return; // Headless
+    
+    int outW = 0, outH = 0;
+    SDL_GetCurrentRenderOutputSize(renderer, &outW, &outH);
+    camera.setViewport(static_cast<float>(outW), static_cast<float>(outH));
+    
+    {
+        PROFILE_SCOPE("Render/Map");
+        map->DrawMap(camera);
+    }
     
-    // Polymorphic Render
-    // Sort by Y for pseudodepth? Optional.
-    for(auto& obj : objects) {
-        obj->render();
+    // Queue what is on screen, then submit one draw call per layer/texture run
+    {
+        PROFILE_SCOPE("Render/Objects");
+        // Sprites are one tile from their position; the margin covers health bars
+        auto visible = [this, alpha](const GameObject& obj) {
+            Point2D p = obj.getRenderPos(alpha);
+            return camera.isVisible({p.getX() - CULL_MARGIN, p.getY() - CULL_MARGIN,
+                                     Map::TILE_SIZE + 2 * CULL_MARGIN, Map::TILE_SIZE + 2 * CULL_MARGIN});
+        };
+        
+        batch.setTransform(camera.getX(), camera.getY(), camera.getZoom());
+        for(auto& t : towers) if (visible(*t)) t->render(batch, alpha);
+        for(auto& e : enemies) if (visible(*e)) e->render(batch, alpha);
+        projectiles.forEach([&](Projectile& p) { if (visible(p)) p.render(batch, alpha); });
+        explosions.forEach([&](Explosion& x) { if (visible(x)) x.render(batch, alpha); });
+        batch.flush();
     }
     
-    renderCursor();
+    {
+        PROFILE_SCOPE("Render/Cursor");
+        renderCursor();
+    }
     
     if (gameOver) {
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
-        SDL_FRect overlay = {0, 0, 800, 600};
+        SDL_FRect overlay = {0, 0, static_cast<float>(outW), static_cast<float>(outH)};
         SDL_RenderFillRect(renderer, &overlay);
     }
 }
 
 void Level::renderCursor() {
-    SDL_FRect r = {cursorX * 32.0f, cursorY * 32.0f, 32.0f, 32.0f};
+    SDL_FRect r = camera.toScreen({cursorX * 32.0f, cursorY * 32.0f, 32.0f, 32.0f});
     SDL_SetRenderDrawColor(renderer, 200, 200, 255, 150); 
     SDL_RenderFillRect(renderer, &r);
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
 }
+
+std::ostream& operator<<(std::ostream& os, const Level& level) {
+    os << "Level [Wave: " << level.currentWave << ", Seed: " << level.seed << ", Frame: " << level.gameTimerFrames
+       << ", Towers: " << level.towers.size() << ", Enemies: " << level.enemies.size()
+       << ", Projectiles: " << level.projectiles.size() << " (peak " << level.projectiles.getHighWater()
+       << "/" << level.projectiles.capacity() << ", dropped " << level.projectiles.getOverflowCount() << ")"
+       << ", Explosions: " << level.explosions.size() << " (peak " << level.explosions.getHighWater()
+       << "/" << level.explosions.capacity() << ", dropped " << level.explosions.getOverflowCount() << ")"
+       << ", State: " << (level.gameOver ? (level.gameWon ? "WON" : "LOST") : "RUNNING") << "]";
+    return os;
+}
@@ -0,0 +1,227 @@
+#include "LevelSnapshot.hpp"
+#include "Level.hpp"
+#include "ByteStream.hpp"
+#include "TowerFactory.h"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+constexpr char MAGIC[4] = {'T', 'D', 'S', 'N'};
+
+// Sanity limit so a corrupt count can't ask for gigabytes
+constexpr uint64_t MAX_OBJECTS = 1u << 20;
+
+TowerType towerTypeOf(const Tower& tower) {
+    if (dynamic_cast<const IceTower*>(&tower)) return TowerType::Ice;
+    if (dynamic_cast<const FireTower*>(&tower)) return TowerType::Fire;
+    return TowerType::Basic;
+}
+
+TowerType readTowerType(ByteReader& in) {
+    uint8_t type = in.byte();
+    if (type > static_cast<uint8_t>(TowerType::Fire)) in.fail("unknown tower type");
+    return static_cast<TowerType>(type);
+}
+
+}
+
+void LevelSnapshot::save(const char* path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) throw ResourceError(std::string("Cannot write snapshot ") + path);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) throw ResourceError(std::string("Failed writing snapshot ") + path);
+}
+
+LevelSnapshot LevelSnapshot::loadFile(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw ResourceError(std::string("Cannot open snapshot ") + path);
+    LevelSnapshot snapshot;
+    snapshot.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return snapshot;
+}
+
+void Level::saveSnapshot(LevelSnapshot& out) const {
+    PROFILE_SCOPE("Level::saveSnapshot");
+    out.bytes.clear();
+    ByteWriter w(out.bytes);
+    w.bytes(MAGIC, sizeof(MAGIC));
+    w.varint(LevelSnapshot::VERSION);
+    w.u64(seed);
+    w.u64(rng.getState().state);
+    w.u64(rng.getState().inc);
+
+    w.sint(cursorX);
+    w.sint(cursorY);
+    w.sint(towersPlaced);
+    w.sint(gameTimerFrames);
+    w.boolean(gameOver);
+    w.boolean(gameWon);
+    w.sint(currentWave);
+    w.sint(frameCount);
+    w.varint(static_cast<uint64_t>(damageDealt));
+    w.byte(static_cast<uint8_t>(selectedTowerType));
+
+    Map::writeTiles(w, map->getTiles());
+    WaveSchedule::write(w, waveDefs);
+    w.varint(spawnSchedule.getCursor());
+
+    w.varint(enemies.size());
+    for (const auto& e : enemies) e->saveState(w);
+
+    w.varint(towers.size());
+    for (const auto& t : towers) {
+        w.byte(static_cast<uint8_t>(towerTypeOf(*t)));
+        t->saveState(w);
+    }
+
+    // Effects name their target by its index in enemies
+    out.enemyIndex.clear();
+    for (size_t i = 0; i < enemies.size(); i++) out.enemyIndex.emplace_back(enemies[i].get(), static_cast<uint32_t>(i));
+    std::sort(out.enemyIndex.begin(), out.enemyIndex.end());
+    auto indexOf = [&out](const Enemy* e) {
+        auto it = std::lower_bound(out.enemyIndex.begin(), out.enemyIndex.end(), std::make_pair(e, uint32_t{0}));
+        return it->second;
+    };
+
+    w.varint(statusEffects.getSlows().size());
+    for (const SlowEffect& s : statusEffects.getSlows()) {
+        w.varint(indexOf(s.target));
+        w.sint(s.ticksLeft);
+        w.f32(s.factor);
+    }
+    w.varint(statusEffects.getBurns().size());
+    for (const BurnEffect& b : statusEffects.getBurns()) {
+        w.varint(indexOf(b.target));
+        w.sint(b.ticksLeft);
+        w.sint(b.damage);
+    }
+
+    projectiles.saveState(w);
+    explosions.saveState(w);
+}
+
+void Level::restoreSnapshot(const LevelSnapshot& snapshot) {
+    PROFILE_SCOPE("Level::restoreSnapshot");
+    Logger::Scope logScope(logger);
+    // The log only moves forward; a rewind would leave it with inputs from a future that didn't happen
+    if (recording) throw LogicError("restoreSnapshot() while recording");
+    ByteReader in(snapshot.bytes.data(), snapshot.bytes.size(), "snapshot");
+    char magic[sizeof(MAGIC)];
+    in.bytes(magic, sizeof(magic));
+    if (!std::equal(magic, magic + sizeof(MAGIC), MAGIC)) in.fail("not a level snapshot");
+    uint64_t version = in.varint();
+    if (version != LevelSnapshot::VERSION) in.fail("unsupported snapshot version " + std::to_string(version));
+
+    // Decode and check everything before touching the level, so a bad
+    // snapshot leaves it exactly as it was
+    uint64_t savedSeed = in.u64();
+    Random::State rngState;
+    rngState.state = in.u64();
+    rngState.inc = in.u64();
+
+    int savedCursorX = in.sint();
+    int savedCursorY = in.sint();
+    int savedTowersPlaced = in.sint();
+    int savedTimer = in.sint();
+    bool savedGameOver = in.boolean();
+    bool savedGameWon = in.boolean();
+    int savedWave = in.sint();
+    int savedFrameCount = in.sint();
+    int64_t savedDamage = static_cast<int64_t>(in.varint());
+    TowerType savedTowerType = readTowerType(in);
+
+    Grid2D<int> tiles;
+    Map::readTiles(in, tiles);
+    std::vector<WaveDef> waves = WaveSchedule::read(in);
+    uint64_t spawnCursor = in.varint();
+
+    // Into the spare objects; only a shortfall is allocated
+    size_t enemyCount = in.count(MAX_OBJECTS, "enemies");
+    if (spareEnemies.size() > enemyCount) spareEnemies.resize(enemyCount);
+    while (spareEnemies.size() < enemyCount) {
+        spareEnemies.push_back(std::make_unique<Enemy>("", Point2D(), 1, 0.0f, renderer));
+    }
+    for (size_t i = 0; i < enemyCount; i++) {
+        spareEnemies[i]->loadState(in);
+        spareEnemies[i]->setSlot(static_cast<int>(i));
+    }
+
+    size_t towerCount = in.count(MAX_OBJECTS, "towers");
+    if (spareTowers.size() > towerCount) spareTowers.resize(towerCount);
+    for (size_t i = 0; i < towerCount; i++) {
+        TowerType type = readTowerType(in);
+        if (i == spareTowers.size()) spareTowers.push_back(TowerFactory::createTower(type, Point2D(), renderer));
+        else if (towerTypeOf(*spareTowers[i]) != type) spareTowers[i] = TowerFactory::createTower(type, Point2D(), renderer);
+        spareTowers[i]->loadState(in);
+        spareTowers[i]->setSlot(static_cast<int>(i));
+    }
+
+    auto enemyIndex = [&]() {
+        uint64_t idx = in.varint();
+        if (idx >= enemyCount) in.fail("effect target out of range");
+        return static_cast<uint32_t>(idx);
+    };
+    restoredSlows.resize(in.count(MAX_OBJECTS, "slows"));
+    for (RestoredEffect& e : restoredSlows) {
+        e.target = enemyIndex();
+        e.ticksLeft = in.sint();
+        e.factor = in.f32();
+    }
+    restoredBurns.resize(in.count(MAX_OBJECTS, "burns"));
+    for (RestoredEffect& e : restoredBurns) {
+        e.target = enemyIndex();
+        e.ticksLeft = in.sint();
+        e.damage = in.sint();
+    }
+
+    spareProjectiles.loadState(in);
+    spareExplosions.loadState(in);
+    if (!in.atEnd()) in.fail("trailing data");
+
+    // All good: commit
+    cursorX = savedCursorX;
+    cursorY = savedCursorY;
+    towersPlaced = savedTowersPlaced;
+    gameTimerFrames = savedTimer;
+    gameOver = savedGameOver;
+    gameWon = savedGameWon;
+    currentWave = savedWave;
+    frameCount = savedFrameCount;
+    damageDealt = savedDamage;
+    selectedTowerType = savedTowerType;
+
+    // Map and waves usually match already; only touch what differs
+    if (tiles.getRows() != map->getRows() || tiles.getCols() != map->getCols()) {
+        loadMap(tiles);
+    } else {
+        for (int r = 0; r < tiles.getRows(); r++) {
+            for (int c = 0; c < tiles.getCols(); c++) map->setTile(r, c, tiles.at(r, c));
+        }
+    }
+    if (savedSeed != seed || waves != waveDefs) {
+        seed = savedSeed;
+        compileWaves(waves);
+    }
+    spawnSchedule.seek(spawnCursor);
+    rng.setState(rngState);
+
+    // Effects hold modifiers on the current enemies; drop them before those change
+    statusEffects.clear();
+    commands.clear();
+    enemies.swap(spareEnemies);
+    towers.swap(spareTowers);
+    for (const RestoredEffect& e : restoredSlows) statusEffects.restoreSlow(*enemies[e.target], e.ticksLeft, e.factor);
+    for (const RestoredEffect& e : restoredBurns) statusEffects.restoreBurn(*enemies[e.target], e.ticksLeft, e.damage);
+    std::swap(projectiles, spareProjectiles);
+    std::swap(explosions, spareExplosions);
+
+    // Same towers and tiles give the same field, whether built at once or goal by goal
+    flowFieldDirty = true;
+    LOG_DEBUG(LogCategory::Level, "Snapshot restored at tick %d (%zu enemies, %zu towers)", gameTimerFrames,
+              enemies.size(), towers.size());
+}
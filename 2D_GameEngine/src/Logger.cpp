@@ -1,16 +1,14 @@
 #include "Logger.hpp"
 
 #include <cstring>
+#include <algorithm>
 
 void Logger::init(const std::string& filename) {
     init(filename.c_str());
 }
 
 void Logger::init(const char* filename) {
-    if (logFile) {
-        std::fclose(logFile);
-        logFile = nullptr;
-    }
+    close();
     if (!filename) {
         std::fprintf(stderr, "Failed to open log file: (null)\n");
         return;
@@ -19,30 +17,199 @@ void Logger::init(const char* filename) {
     logFile = std::fopen(filename, "w");
     if (!logFile) {
         std::fprintf(stderr, "Failed to open log file: %s\n", filename);
+        return;
+    }
+
+    if (!slots) slots = std::make_unique<Slot[]>(QUEUE_CAPACITY);
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
     }
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos = 0;
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(&Logger::writerLoop, this);
 }
 
 void Logger::log(const std::string& message) {
-    log(message.c_str());
+    log(message.data(), message.size());
 }
 
 void Logger::log(const char* message) {
     if (!message) {
         message = "(null)";
     }
-    if (logFile) {
-        std::fwrite(message, 1, std::strlen(message), logFile);
-        std::fwrite("\n", 1, 1, logFile);
-        std::fflush(logFile);
-    } else {
-        std::fprintf(stdout, "[Console Fallback]: %s\n", message);
+    log(message, std::strlen(message));
+}
+
+void Logger::log(const char* message, size_t length) {
+    if (!running.load(std::memory_order_acquire)) {
+        logConsole(message, length);
+        return;
+    }
+    length = std::min(length, MAX_MESSAGE);
+
+    // Claim a slot (bounded MPMC ring, used here with a single consumer)
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    bool waited = false;
+    for (;;) {
+        slot = &slots[pos & (QUEUE_CAPACITY - 1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Ring is full
+            if (overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::Drop) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (!waited) {
+                blocked.fetch_add(1, std::memory_order_relaxed);
+                waited = true;
+            }
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(slot->text, message, length);
+    slot->length = static_cast<uint32_t>(length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Logger::logConsole(const char* message, size_t length) {
+    std::fprintf(stdout, "[Console Fallback]: %.*s\n", static_cast<int>(length), message);
+    std::fflush(stdout);
+}
+
+size_t Logger::drainBatch(std::string& batch) {
+    batch.clear();
+    size_t count = 0;
+    while (count < QUEUE_CAPACITY) {
+        Slot& slot = slots[dequeuePos & (QUEUE_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break; // empty
+
+        batch.append(slot.text, slot.length);
+        batch.push_back('\n');
+        slot.sequence.store(dequeuePos + QUEUE_CAPACITY, std::memory_order_release);
+        dequeuePos++;
+        count++;
+    }
+    return count;
+}
+
+void Logger::writerLoop() {
+    std::string batch;
+    batch.reserve(QUEUE_CAPACITY * 64);
+    auto lastFlush = std::chrono::steady_clock::now();
+    uint64_t reportedDrops = dropped.load(std::memory_order_relaxed);
+
+    for (;;) {
+        bool stopping = !running.load(std::memory_order_acquire);
+        uint64_t flushTarget = flushRequests.load(std::memory_order_acquire);
+
+        size_t count = drainBatch(batch);
+        if (count > 0) {
+            std::fwrite(batch.data(), 1, batch.size(), logFile);
+            written.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::fprintf(logFile, "[Logger] %llu messages dropped (queue full)\n",
+                         static_cast<unsigned long long>(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        bool doFlush = false;
+        switch (flushPolicy.load(std::memory_order_relaxed)) {
+            case FlushPolicy::EveryBatch:
+                doFlush = count > 0;
+                break;
+            case FlushPolicy::Interval:
+                doFlush = now - lastFlush >= std::chrono::milliseconds(flushIntervalMs.load(std::memory_order_relaxed));
+                break;
+            case FlushPolicy::OnClose:
+                break;
+        }
+        // An explicit flush() is satisfied once the ring has been drained
+        if (count == 0 && flushTarget != flushesDone.load(std::memory_order_relaxed)) {
+            doFlush = true;
+        }
+        if (doFlush) {
+            std::fflush(logFile);
+            lastFlush = now;
+            if (count == 0) flushesDone.store(flushTarget, std::memory_order_release);
+        }
+
+        if (count == 0) {
+            if (stopping) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::fflush(logFile);
+}
+
+void Logger::flush() {
+    if (!running.load(std::memory_order_acquire)) {
         std::fflush(stdout);
+        return;
     }
+    uint64_t target = flushRequests.fetch_add(1, std::memory_order_acq_rel) + 1;
+    while (flushesDone.load(std::memory_order_acquire) < target && running.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void Logger::setFlushPolicy(FlushPolicy policy, std::chrono::milliseconds interval) {
+    flushIntervalMs.store(interval.count(), std::memory_order_relaxed);
+    flushPolicy.store(policy, std::memory_order_relaxed);
 }
 
 void Logger::close() {
+    if (running.exchange(false, std::memory_order_acq_rel)) {
+        // The writer drains whatever is left before exiting
+        writer.join();
+    }
     if (logFile) {
         std::fclose(logFile);
         logFile = nullptr;
     }
 }
+
+void Logger::setMinLevel(LogLevel level) {
+    for (auto& l : categoryLevels) l.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::setCategoryLevel(LogCategory category, LogLevel level) {
+    categoryLevels[static_cast<int>(category)].store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Off:   break;
+    }
+    return "OFF";
+}
+
+const char* Logger::categoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:  return "General";
+        case LogCategory::Game:     return "Game";
+        case LogCategory::Level:    return "Level";
+        case LogCategory::Combat:   return "Combat";
+        case LogCategory::Resource: return "Resource";
+        case LogCategory::Count:    break;
+    }
+    return "?";
+}
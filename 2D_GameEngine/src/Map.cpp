@@ -2,60 +2,194 @@
 #include "GameObject.h"
 #include "TextureManager.h"
 #include "Logger.hpp"
+#include "ByteStream.hpp"
 
-Map::Map(SDL_Renderer* ren) {
+#include <algorithm>
+
+Map::Map(SDL_Renderer* ren) : map(DEFAULT_ROWS, DEFAULT_COLS) {
     renderer = ren;
     
+    src.x = src.y = 0;
+    src.w = dest.w = 32;
+    src.h = dest.h = 32;
+    
+    dest.x = dest.y = 0;
+    
+    resizeChunks();
+    
+    // Headless: keep the tile grid but skip texture loading
+    if (!renderer) return;
+    
     try {
-        grass = TextureManager::LoadTexture("assets/map_tile.bmp", ren);
-        dirt = TextureManager::LoadTexture("assets/path_tile.bmp", ren);
+        grass = TextureManager::Acquire("assets/map_tile.bmp", ren);
+        dirt = TextureManager::Acquire("assets/path_tile.bmp", ren);
     } catch (const ResourceError&) {
         throw;
     }
     
     try {
-        water = TextureManager::LoadTexture("assets/water.png", ren);
+        water = TextureManager::Acquire("assets/water.png", ren);
     } catch (const ResourceError&) {
         // Optional texture
-        Logger::getInstance().log("Warning: Water texture missing. Proceeding without it.");
+        LOG_WARN(LogCategory::Resource, "Water texture missing. Proceeding without it.");
         water = nullptr;
     }
-    
-    src.x = src.y = 0;
-    src.w = dest.w = 32;
-    src.h = dest.h = 32;
-    
-    dest.x = dest.y = 0;
 }
 
 Map::~Map() {
-    SDL_DestroyTexture(grass);
-    SDL_DestroyTexture(dirt);
+    // Textures are released by their shared handles
+}
+
+void Map::LoadMap(const Grid2D<int>& tiles) {
+    bool resized = tiles.getRows() != map.getRows() || tiles.getCols() != map.getCols();
+    map = tiles;
+    if (resized) resizeChunks();
+    revision++;
+    invalidate();
+}
+
+void Map::setTile(int row, int col, int type) {
+    if (!map.inBounds(row, col) || map.at(row, col) == type) return;
+    map.at(row, col) = type;
+    revision++;
+    chunks[(row / CHUNK_TILES) * chunkCols + col / CHUNK_TILES].dirty = true;
+}
+
+Grid2D<int> Map::defaultTiles(int cols, int rows) {
+    Grid2D<int> tiles(rows, cols, 0); // Fill with Grass (0)
+    for (int c = 0; c < cols; c++) tiles.set(rows / 2, c, 1); // Set Path (1) across the middle
+    return tiles;
+}
+
+void Map::writeTiles(ByteWriter& out, const Grid2D<int>& tiles) {
+    out.varint(static_cast<uint32_t>(tiles.getCols()));
+    out.varint(static_cast<uint32_t>(tiles.getRows()));
+    for (int r = 0; r < tiles.getRows(); r++) {
+        for (int c = 0; c < tiles.getCols(); c++) out.sint(tiles.get(r, c));
+    }
 }
 
-void Map::LoadMap(int arr[20][25]) {
-    map.loadFromRaw(arr);
+void Map::readTiles(ByteReader& in, Grid2D<int>& tiles) {
+    constexpr uint64_t MAX_SIDE = 1u << 12; // 4096 tiles
+    size_t cols = in.count(MAX_SIDE, "map columns");
+    size_t rows = in.count(MAX_SIDE, "map rows");
+    if (cols == 0 || rows == 0) in.fail("empty map");
+    tiles.resize(static_cast<int>(rows), static_cast<int>(cols));
+    for (int r = 0; r < tiles.getRows(); r++) {
+        for (int c = 0; c < tiles.getCols(); c++) tiles.set(r, c, in.sint());
+    }
+}
+
+void Map::invalidate() {
+    for (Chunk& c : chunks) c.dirty = true;
+}
+
+void Map::resetTileLayer() {
+    for (Chunk& c : chunks) {
+        c.texture.reset();
+        c.dirty = true;
+    }
+}
+
+void Map::resizeChunks() {
+    chunkRows = (map.getRows() + CHUNK_TILES - 1) / CHUNK_TILES;
+    chunkCols = (map.getCols() + CHUNK_TILES - 1) / CHUNK_TILES;
+    chunks.clear();
+    chunks.resize(static_cast<size_t>(chunkRows) * chunkCols);
+    layerUnsupported = false;
+}
+
+bool Map::bakeChunk(int chunkRow, int chunkCol) {
+    Chunk& chunk = chunks[chunkRow * chunkCols + chunkCol];
+    int row0 = chunkRow * CHUNK_TILES, col0 = chunkCol * CHUNK_TILES;
+    int row1 = std::min(row0 + CHUNK_TILES, map.getRows());
+    int col1 = std::min(col0 + CHUNK_TILES, map.getCols());
+
+    if (!chunk.texture) {
+        // Edge chunks are cut to the map
+        SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                             (col1 - col0) * TILE_SIZE, (row1 - row0) * TILE_SIZE);
+        if (!tex) {
+            LOG_WARN(LogCategory::Resource, "Tile chunk render target unavailable (%s). Drawing tiles directly.",
+                     SDL_GetError());
+            layerUnsupported = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+        SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
+        chunk.texture = TextureHandle(tex, SDL_DestroyTexture);
+    }
+
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    if (!SDL_SetRenderTarget(renderer, chunk.texture.get())) {
+        LOG_WARN(LogCategory::Resource, "Failed to bind tile chunk (%s). Drawing tiles directly.", SDL_GetError());
+        chunk.texture.reset();
+        layerUnsupported = true;
+        return false;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    drawTiles(row0, row1, col0, col1, col0 * static_cast<float>(TILE_SIZE), row0 * static_cast<float>(TILE_SIZE), 1.0f);
+    SDL_SetRenderTarget(renderer, previous);
+
+    chunk.dirty = false;
+    bakeCount++;
+    LOG_DEBUG(LogCategory::Resource, "Baked tile chunk (%d, %d), total bakes %d", chunkCol, chunkRow, bakeCount);
+    return true;
 }
 
-void Map::DrawMap() {
-    for (int row = 0; row < 20; row++) {
-        for (int col = 0; col < 25; col++) {
-            int type = map.get(row, col);
+void Map::drawTiles(int row0, int row1, int col0, int col1, float originX, float originY, float scale) {
+    dest.w = dest.h = TILE_SIZE * scale;
+    for (int row = row0; row < row1; row++) {
+        for (int col = col0; col < col1; col++) {
+            int type = map.at(row, col);
             
-            dest.x = col * 32;
-            dest.y = row * 32;
+            dest.x = (col * TILE_SIZE - originX) * scale;
+            dest.y = (row * TILE_SIZE - originY) * scale;
             
             switch (type) {
                 case 0:
-                    SDL_RenderTexture(renderer, grass, &src, &dest);
+                    SDL_RenderTexture(renderer, grass.get(), &src, &dest);
                     break;
                 case 1:
-                    SDL_RenderTexture(renderer, dirt, &src, &dest);
+                    SDL_RenderTexture(renderer, dirt.get(), &src, &dest);
                     break;
                 default:
-                    SDL_RenderTexture(renderer, grass, &src, &dest);
+                    SDL_RenderTexture(renderer, grass.get(), &src, &dest);
                     break;
             }
         }
     }
 }
+
+void Map::DrawMap(const Camera& camera) {
+    chunksDrawn = 0;
+    if (!renderer) return;
+
+    // Chunks overlapping the view
+    const float chunkPx = static_cast<float>(CHUNK_TILES * TILE_SIZE);
+    SDL_FRect view = camera.getView();
+    int c0 = std::max(0, static_cast<int>(view.x / chunkPx));
+    int r0 = std::max(0, static_cast<int>(view.y / chunkPx));
+    int c1 = std::min(chunkCols - 1, static_cast<int>((view.x + view.w) / chunkPx));
+    int r1 = std::min(chunkRows - 1, static_cast<int>((view.y + view.h) / chunkPx));
+
+    for (int cr = r0; cr <= r1; cr++) {
+        for (int cc = c0; cc <= c1; cc++) {
+            int row0 = cr * CHUNK_TILES, col0 = cc * CHUNK_TILES;
+            int row1 = std::min(row0 + CHUNK_TILES, map.getRows());
+            int col1 = std::min(col0 + CHUNK_TILES, map.getCols());
+
+            Chunk& chunk = chunks[cr * chunkCols + cc];
+            if (layerUnsupported || (chunk.dirty && !bakeChunk(cr, cc))) {
+                drawTiles(row0, row1, col0, col1, camera.getX(), camera.getY(), camera.getZoom());
+            } else {
+                SDL_FRect world = {col0 * static_cast<float>(TILE_SIZE), row0 * static_cast<float>(TILE_SIZE),
+                                   (col1 - col0) * static_cast<float>(TILE_SIZE), (row1 - row0) * static_cast<float>(TILE_SIZE)};
+                SDL_FRect screen = camera.toScreen(world);
+                SDL_RenderTexture(renderer, chunk.texture.get(), nullptr, &screen);
+            }
+            chunksDrawn++;
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include "Profiler.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+int Profiler::registerPhase(const char* name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (phases[i].name == name) return static_cast<int>(i);
+    }
+    if (phases.size() >= MAX_PHASES) {
+        LOG_WARN(LogCategory::General, "Profiler: too many phases, ignoring '%s'", name);
+        return -1;
+    }
+    if (phases.capacity() < MAX_PHASES) phases.reserve(MAX_PHASES);
+    phases.emplace_back();
+    phases.back().name = name;
+    return static_cast<int>(phases.size() - 1);
+}
+
+uint32_t Profiler::threadIndex() {
+    static std::atomic<uint32_t> nextIndex{0};
+    thread_local uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void Profiler::record(int phase, uint64_t startNs, uint64_t durationNs) {
+    if (phase < 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Phase& p = phases[phase];
+    p.samples[p.next] = durationNs;
+    p.next = (p.next + 1) % HISTORY;
+    p.count++;
+
+    if (tracing && events.size() < MAX_TRACE_EVENTS) {
+        events.push_back({phase, threadIndex(), startNs, durationNs});
+    }
+}
+
+std::vector<Profiler::Stats> Profiler::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Stats> result;
+    result.reserve(phases.size());
+
+    uint64_t window[HISTORY];
+    for (const Phase& p : phases) {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(p.count, HISTORY));
+        Stats s{p.name, p.count, 0.0, 0.0, 0.0, 0.0};
+        if (n > 0) {
+            std::copy(p.samples, p.samples + n, window);
+            uint64_t total = 0;
+            for (size_t i = 0; i < n; ++i) total += window[i];
+            auto [lo, hi] = std::minmax_element(window, window + n);
+            s.minUs = *lo / 1000.0;
+            s.maxUs = *hi / 1000.0;
+            s.avgUs = static_cast<double>(total) / n / 1000.0;
+
+            size_t rank = (n * 99 + 99) / 100 - 1; // nearest-rank p99
+            std::nth_element(window, window + rank, window + n);
+            s.p99Us = window[rank] / 1000.0;
+        }
+        result.push_back(std::move(s));
+    }
+    return result;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Phase& p : phases) {
+        p.next = 0;
+        p.count = 0;
+    }
+    events.clear();
+}
+
+void Profiler::startTrace() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    events.reserve(64 * 1024);
+    traceStartNs = nowNs();
+    tracing = true;
+}
+
+void Profiler::stopTrace() {
+    std::lock_guard<std::mutex> lock(mutex);
+    tracing = false;
+}
+
+size_t Profiler::getTraceEventCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+bool Profiler::writeChromeTrace(const char* path) const {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) {
+        LOG_WARN(LogCategory::General, "Profiler: cannot write trace to %s", path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        // Complete ("X") events, timestamps in microseconds from capture start
+        std::fprintf(f, "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                     phases[e.phase].name.c_str(), e.thread,
+                     (e.startNs - std::min(e.startNs, traceStartNs)) / 1000.0, e.durationNs / 1000.0,
+                     i + 1 < events.size() ? "," : "");
+    }
+    std::fputs("]}\n", f);
+
+    bool ok = std::ferror(f) == 0;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) LOG_WARN(LogCategory::General, "Profiler: error while writing %s", path);
+    return ok;
+}
+
+bool Profiler::writeCsv(const char* path) const {
+    std::vector<Stats> stats = getStats();
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) {
+        LOG_WARN(LogCategory::General, "Profiler: cannot write stats to %s", path);
+        return false;
+    }
+
+    std::fputs("phase,count,min_us,avg_us,p99_us,max_us\n", f);
+    for (const Stats& s : stats) {
+        std::fprintf(f, "%s,%llu,%.3f,%.3f,%.3f,%.3f\n", s.name.c_str(),
+                     static_cast<unsigned long long>(s.count), s.minUs, s.avgUs, s.p99Us, s.maxUs);
+    }
+
+    bool ok = std::ferror(f) == 0;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) LOG_WARN(LogCategory::General, "Profiler: error while writing %s", path);
+    return ok;
+}
+
+void Profiler::drawOverlay(SDL_Renderer* ren, float x, float y) const {
+    if (!ren) return;
+    std::vector<Stats> stats = getStats();
+
+    const float line = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2.0f;
+    SDL_FRect bg = {x - 4, y - 4, 44 * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 8.0f, (stats.size() + 1) * line + 8};
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 180);
+    SDL_RenderFillRect(ren, &bg);
+
+    char text[96];
+    SDL_SetRenderDrawColor(ren, 255, 255, 0, 255);
+    std::snprintf(text, sizeof(text), "%-20s %7s %7s %7s", "phase (us)", "min", "avg", "p99");
+    SDL_RenderDebugText(ren, x, y, text);
+
+    SDL_SetRenderDrawColor(ren, 255, 255, 255, 255);
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const Stats& s = stats[i];
+        std::snprintf(text, sizeof(text), "%-20.20s %7.1f %7.1f %7.1f", s.name.c_str(), s.minUs, s.avgUs, s.p99Us);
+        SDL_RenderDebugText(ren, x, y + (i + 1) * line, text);
+    }
+}
@@ -0,0 +1,95 @@
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+
+uint32_t SpriteBatch::textureRank(SDL_Texture* texture) {
+    // A frame only uses a handful of textures; a linear scan beats hashing
+    for (size_t i = 0; i < textures.size(); ++i) {
+        if (textures[i] == texture) return static_cast<uint32_t>(i);
+    }
+    textures.push_back(texture);
+    return static_cast<uint32_t>(textures.size() - 1);
+}
+
+void SpriteBatch::push(Layer layer, SDL_Texture* texture, const SDL_FRect& dst, SDL_Color color,
+                       float u0, float v0, float u1, float v1) {
+    Quad q;
+    q.texture = texture;
+    q.key = (static_cast<uint32_t>(layer) << 16) | textureRank(texture);
+
+    SDL_FColor c = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    float x0 = (dst.x - viewX) * viewScale, y0 = (dst.y - viewY) * viewScale;
+    float x1 = x0 + dst.w * viewScale, y1 = y0 + dst.h * viewScale;
+    q.vertices[0] = {{x0, y0}, c, {u0, v0}};
+    q.vertices[1] = {{x1, y0}, c, {u1, v0}};
+    q.vertices[2] = {{x1, y1}, c, {u1, v1}};
+    q.vertices[3] = {{x0, y1}, c, {u0, v1}};
+    quads.push_back(q);
+}
+
+void SpriteBatch::setTransform(float offsetX, float offsetY, float scale) {
+    viewX = offsetX;
+    viewY = offsetY;
+    viewScale = scale;
+}
+
+void SpriteBatch::draw(Layer layer, SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst,
+                       SDL_Color tint) {
+    if (!texture) return;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src) {
+        float w = 0.0f, h = 0.0f;
+        if (SDL_GetTextureSize(texture, &w, &h) && w > 0.0f && h > 0.0f) {
+            u0 = src->x / w;
+            v0 = src->y / h;
+            u1 = (src->x + src->w) / w;
+            v1 = (src->y + src->h) / h;
+        }
+    }
+    push(layer, texture, dst, tint, u0, v0, u1, v1);
+}
+
+void SpriteBatch::fillRect(Layer layer, const SDL_FRect& dst, SDL_Color color) {
+    push(layer, nullptr, dst, color, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void SpriteBatch::flush() {
+    lastDrawCalls = 0;
+    lastQuadCount = static_cast<int>(quads.size());
+    if (quads.empty() || !renderer) {
+        quads.clear();
+        textures.clear();
+        return;
+    }
+
+    order.resize(quads.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<uint32_t>(i);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return quads[a].key < quads[b].key;
+    });
+
+    size_t runStart = 0;
+    while (runStart < order.size()) {
+        uint32_t key = quads[order[runStart]].key;
+        size_t runEnd = runStart;
+
+        vertices.clear();
+        indices.clear();
+        while (runEnd < order.size() && quads[order[runEnd]].key == key) {
+            const Quad& q = quads[order[runEnd]];
+            int base = static_cast<int>(vertices.size());
+            vertices.insert(vertices.end(), q.vertices, q.vertices + 4);
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+            runEnd++;
+        }
+
+        SDL_RenderGeometry(renderer, quads[order[runStart]].texture,
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+        lastDrawCalls++;
+        runStart = runEnd;
+    }
+
+    quads.clear();
+    textures.clear();
+}
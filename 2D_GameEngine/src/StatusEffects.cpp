@@ -0,0 +1,131 @@
+#include "StatusEffects.hpp"
+#include "GameObject.h"
+#include "CommandBuffer.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+// Indexed by EffectType
+constexpr StackRule STACK_RULES[] = {
+    StackRule::Ignore, // Slow
+    StackRule::Stack,  // Burn
+};
+static_assert(sizeof(STACK_RULES) / sizeof(STACK_RULES[0]) == static_cast<size_t>(EffectType::Count),
+              "every effect type needs a stack rule");
+
+// Swap-remove every record matching pred, calling onRemove(record) first
+template <typename Record, typename Pred, typename OnRemove>
+void removeIf(std::vector<Record>& records, Pred pred, OnRemove onRemove) {
+    size_t i = 0;
+    while (i < records.size()) {
+        if (pred(records[i])) {
+            onRemove(records[i]);
+            records[i] = records.back();
+            records.pop_back();
+        } else {
+            i++;
+        }
+    }
+}
+
+}
+
+StackRule StatusEffects::getRule(EffectType type) {
+    return STACK_RULES[static_cast<size_t>(type)];
+}
+
+template <typename Record>
+bool StatusEffects::admit(std::vector<Record>& records, Enemy& target, EffectType type, int ticks) {
+    if (target.getEffectCount(type) > 0) {
+        switch (getRule(type)) {
+            case StackRule::Ignore:
+                return false;
+            case StackRule::Refresh:
+                for (Record& r : records) {
+                    if (r.target == &target) r.ticksLeft = ticks;
+                }
+                return false;
+            case StackRule::Stack:
+                break;
+        }
+    }
+    target.effectCounts[static_cast<size_t>(type)]++;
+    return true;
+}
+
+void StatusEffects::expire(Enemy* target, EffectType type) {
+    target->effectCounts[static_cast<size_t>(type)]--;
+}
+
+void StatusEffects::addSlow(Enemy& target, int ticks, float factor) {
+    if (!admit(slows, target, EffectType::Slow, ticks)) return;
+    slows.push_back({&target, ticks, factor, target.getSpeedStat().addModifier(ModifierOp::Multiply, factor)});
+    LOG_TRACE(LogCategory::Combat, "Slow applied!");
+}
+
+void StatusEffects::addBurn(Enemy& target, int ticks, int damage) {
+    if (!admit(burns, target, EffectType::Burn, ticks)) return;
+    burns.push_back({&target, ticks, damage});
+}
+
+void StatusEffects::restoreSlow(Enemy& target, int ticksLeft, float factor) {
+    target.effectCounts[static_cast<size_t>(EffectType::Slow)]++;
+    slows.push_back({&target, ticksLeft, factor, target.getSpeedStat().addModifier(ModifierOp::Multiply, factor)});
+}
+
+void StatusEffects::restoreBurn(Enemy& target, int ticksLeft, int damage) {
+    target.effectCounts[static_cast<size_t>(EffectType::Burn)]++;
+    burns.push_back({&target, ticksLeft, damage});
+}
+
+int StatusEffects::update(CommandBuffer& commands) {
+    for (SlowEffect& s : slows) s.ticksLeft--;
+    removeIf(slows, [](const SlowEffect& s) { return s.ticksLeft <= 0; }, [this](const SlowEffect& s) {
+        s.target->getSpeedStat().removeModifier(s.modifier);
+        expire(s.target, EffectType::Slow);
+        LOG_TRACE(LogCategory::Combat, "Slow removed!");
+    });
+
+    int dealt = 0;
+    for (BurnEffect& b : burns) {
+        b.ticksLeft--;
+        if (b.ticksLeft % BURN_INTERVAL == 0) {
+            int before = b.target->getHealth();
+            b.target->takeDamage(b.damage);
+            dealt += before - b.target->getHealth();
+            if (before > 0 && !b.target->isActive()) commands.destroy(*b.target);
+            LOG_TRACE(LogCategory::Combat, "Burn tick!");
+        }
+    }
+    removeIf(burns, [](const BurnEffect& b) { return b.ticksLeft <= 0; }, [this](const BurnEffect& b) {
+        expire(b.target, EffectType::Burn);
+    });
+    return dealt;
+}
+
+void StatusEffects::removeInactive() {
+    removeIf(slows, [](const SlowEffect& s) { return !s.target->isActive(); }, [this](const SlowEffect& s) {
+        s.target->getSpeedStat().removeModifier(s.modifier);
+        expire(s.target, EffectType::Slow);
+    });
+    removeIf(burns, [](const BurnEffect& b) { return !b.target->isActive(); },
+             [this](const BurnEffect& b) { expire(b.target, EffectType::Burn); });
+}
+
+void StatusEffects::clear() {
+    for (const SlowEffect& s : slows) {
+        s.target->getSpeedStat().removeModifier(s.modifier);
+        expire(s.target, EffectType::Slow);
+    }
+    for (const BurnEffect& b : burns) expire(b.target, EffectType::Burn);
+    slows.clear();
+    burns.clear();
+}
+
+size_t StatusEffects::count(EffectType type) const {
+    switch (type) {
+        case EffectType::Slow: return slows.size();
+        case EffectType::Burn: return burns.size();
+        default: return 0;
+    }
+}
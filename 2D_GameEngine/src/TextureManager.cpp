@@ -1,9 +1,13 @@
 #include "TextureManager.h"
 #include "GameObject.h"
 
+std::unordered_map<std::string, TextureManager::Entry> TextureManager::cache;
+int TextureManager::loadCount = 0;
+
 SDL_Texture* TextureManager::LoadTexture(const char* fileName, SDL_Renderer* ren) {
     if (!ren) throw InitializationError("Renderer is null in LoadTexture");
-    
+
+    loadCount++;
     SDL_Surface* tempSurface = IMG_Load(fileName);
     if (!tempSurface) {
         std::string err = "Failed to load texture: ";
@@ -12,9 +16,56 @@ SDL_Texture* TextureManager::LoadTexture(const char* fileName, SDL_Renderer* ren
     }
     SDL_Texture* tex = SDL_CreateTextureFromSurface(ren, tempSurface);
     SDL_DestroySurface(tempSurface);
-    
+
     if (!tex) {
          throw ResourceError("Failed to convert surface to texture for: " + std::string(fileName));
     }
     return tex;
 }
+
+TextureHandle TextureManager::Acquire(const char* fileName, SDL_Renderer* ren) {
+    if (!ren) throw InitializationError("Renderer is null in Acquire");
+    if (!fileName) throw ResourceError("Texture path is null");
+
+    auto it = cache.find(fileName);
+    if (it != cache.end() && it->second.renderer == ren) {
+        if (!it->second.error.empty()) throw ResourceError(it->second.error);
+        return it->second.texture;
+    }
+
+    Entry entry;
+    entry.renderer = ren;
+    try {
+        entry.texture = TextureHandle(LoadTexture(fileName, ren), SDL_DestroyTexture);
+    } catch (const ResourceError& e) {
+        // Negative cache: remember the failure so we don't hit the disk again
+        entry.error = e.what();
+        cache.insert_or_assign(fileName, std::move(entry));
+        throw;
+    }
+
+    TextureHandle tex = entry.texture;
+    cache.insert_or_assign(fileName, std::move(entry));
+    return tex;
+}
+
+void TextureManager::Purge() {
+    std::erase_if(cache, [](const auto& kv) {
+        return kv.second.texture && kv.second.texture.use_count() == 1;
+    });
+}
+
+void TextureManager::Clear() {
+    cache.clear();
+}
+
+long TextureManager::getRefCount(const std::string& fileName) {
+    auto it = cache.find(fileName);
+    if (it == cache.end() || !it->second.texture) return 0;
+    // Exclude the reference held by the cache itself
+    return it->second.texture.use_count() - 1;
+}
+
+int TextureManager::getCachedCount() {
+    return static_cast<int>(cache.size());
+}
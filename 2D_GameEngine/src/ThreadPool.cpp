@@ -0,0 +1,148 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Which pool (if any) the current thread works for, and its queue
+thread_local const ThreadPool* workerPool = nullptr;
+thread_local size_t workerIndex = 0;
+
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    queues.reserve(threads);
+    for (size_t i = 0; i < threads; i++) queues.push_back(std::make_unique<Queue>());
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++) workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+size_t ThreadPool::homeQueue() const {
+    return workerPool == this ? workerIndex : queues.size();
+}
+
+void ThreadPool::submit(TaskGroup& group, std::function<void()> task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    size_t index = homeQueue();
+    if (index == queues.size()) index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    // Counted before it is visible, so a thief never sees more tasks than the count
+    queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(Task{std::move(task), &group});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::take(size_t home, const TaskGroup* only, Task& out) {
+    if (queued.load(std::memory_order_acquire) == 0) return false;
+
+    if (home < queues.size()) {
+        Queue& own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        // Newest first; a waiting worker looks past tasks submitted from outside
+        for (auto it = own.tasks.rbegin(); it != own.tasks.rend(); ++it) {
+            if (only && it->group != only) continue;
+            out = std::move(*it);
+            own.tasks.erase(std::next(it).base());
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    if (only) return false;
+
+    // Steal the oldest task, starting with the next queue along
+    size_t n = queues.size();
+    size_t start = home < n ? home + 1 : 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t index = (start + i) % n;
+        if (index == home) continue;
+        Queue& victim = *queues[index];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::finish(Task& task) {
+    TaskGroup* group = task.group;
+    try {
+        task.run();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->errorMutex);
+        if (!group->error) group->error = std::current_exception();
+    }
+    task.run = nullptr; // captures go before the group can be released
+
+    if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        done.notify_all();
+    }
+}
+
+bool ThreadPool::tryRunOne(size_t home, const TaskGroup* only) {
+    Task task;
+    if (!take(home, only, task)) return false;
+    finish(task);
+    return true;
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    size_t home = homeQueue();
+    // A worker only helps with the group's own tasks (still on its queue);
+    // picking up unrelated work here could nest without bound
+    const TaskGroup* only = home < queues.size() ? &group : nullptr;
+
+    while (group.pending.load(std::memory_order_acquire) > 0) {
+        if (tryRunOne(home, only)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (only) {
+            done.wait(lock, [&group] { return group.pending.load(std::memory_order_acquire) == 0; });
+        } else {
+            // Submitting doesn't signal done; check for new work now and then
+            done.wait_for(lock, std::chrono::milliseconds(1), [this, &group] {
+                return group.pending.load(std::memory_order_acquire) == 0 || queued.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(group.errorMutex);
+        error = std::exchange(group.error, nullptr);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    workerPool = this;
+    workerIndex = index;
+    for (;;) {
+        if (tryRunOne(index, nullptr)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
@@ -0,0 +1,267 @@
+#include "WaveSchedule.hpp"
+#include "GameObject.h"
+#include "ByteStream.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Legacy spawner cadence: one enemy every 150 ticks
+constexpr int DEFAULT_SPAWN_INTERVAL = 150;
+
+bool parseKind(const std::string& name, EnemyKind& out) {
+    if (name == "goblin") out = EnemyKind::Goblin;
+    else if (name == "orc") out = EnemyKind::Orc;
+    else return false;
+    return true;
+}
+
+bool parseLane(const std::string& name, SpawnLane& out) {
+    if (name == "top") out = SpawnLane::Top;
+    else if (name == "bottom") out = SpawnLane::Bottom;
+    else if (name == "left") out = SpawnLane::Left;
+    else if (name == "right") out = SpawnLane::Right;
+    else return false;
+    return true;
+}
+
+bool parseInt(const std::string& text, int& out) {
+    try {
+        size_t used = 0;
+        out = std::stoi(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::vector<std::string> split(const std::string& text, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, sep)) parts.push_back(part);
+    return parts;
+}
+
+std::vector<std::pair<EnemyKind, int>> defaultMix() {
+    return {{EnemyKind::Goblin, 1}, {EnemyKind::Orc, 1}};
+}
+
+// Why parse() would reject w as a whole, or empty if it wouldn't
+std::string checkWave(const WaveDef& w) {
+    if (w.startTick < 0 || w.startTick > WaveSchedule::MAX_TICK) return "start out of range";
+    if (w.count <= 0 || w.count > WaveSchedule::MAX_SPAWNS) return "count out of range";
+    if (w.intervalTicks <= 0 || w.intervalTicks > WaveSchedule::MAX_TICK) return "interval out of range";
+    if (w.burst <= 0 || w.burst > WaveSchedule::MAX_SPAWNS) return "burst out of range";
+    if (w.mix.empty()) return "empty mix";
+    int64_t totalWeight = 0;
+    for (const auto& m : w.mix) {
+        if (m.second <= 0) return "mix weight out of range";
+        totalWeight += m.second;
+    }
+    if (totalWeight > INT_MAX) return "mix weights too large";
+    if (w.lanes.empty()) return "empty lanes";
+    int64_t lastTick = w.startTick + static_cast<int64_t>((w.count - 1) / w.burst) * w.intervalTicks;
+    if (lastTick > WaveSchedule::MAX_TICK) return "wave runs past tick " + std::to_string(WaveSchedule::MAX_TICK);
+    return "";
+}
+
+std::vector<SpawnLane> allLanes() {
+    // Order matters: lane index is drawn uniformly, as the old side roll was
+    return {SpawnLane::Top, SpawnLane::Bottom, SpawnLane::Left, SpawnLane::Right};
+}
+
+}
+
+std::vector<WaveDef> WaveSchedule::parse(std::istream& in, const std::string& sourceName) {
+    std::vector<WaveDef> waves;
+    std::string line;
+    int lineNo = 0;
+    int spawns = 0;
+
+    auto fail = [&](const std::string& why) {
+        throw ResourceError(sourceName + ":" + std::to_string(lineNo) + ": " + why);
+    };
+
+    while (std::getline(in, line)) {
+        lineNo++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream tokens(line);
+        std::string word;
+        if (!(tokens >> word)) continue; // blank or comment
+        if (word != "wave") fail("expected 'wave', got '" + word + "'");
+
+        WaveDef w;
+        w.mix = defaultMix();
+        w.lanes = allLanes();
+        bool haveCount = false, haveInterval = false;
+
+        while (tokens >> word) {
+            size_t eq = word.find('=');
+            if (eq == std::string::npos) fail("expected key=value, got '" + word + "'");
+            std::string key = word.substr(0, eq);
+            std::string value = word.substr(eq + 1);
+
+            if (key == "start") {
+                if (!parseInt(value, w.startTick) || w.startTick < 0) fail("bad start '" + value + "'");
+            } else if (key == "count") {
+                if (!parseInt(value, w.count) || w.count <= 0) fail("bad count '" + value + "'");
+                haveCount = true;
+            } else if (key == "interval") {
+                if (!parseInt(value, w.intervalTicks) || w.intervalTicks <= 0) fail("bad interval '" + value + "'");
+                haveInterval = true;
+            } else if (key == "burst") {
+                if (!parseInt(value, w.burst) || w.burst <= 0) fail("bad burst '" + value + "'");
+            } else if (key == "mix") {
+                w.mix.clear();
+                for (const std::string& entry : split(value, ',')) {
+                    auto parts = split(entry, ':');
+                    std::pair<EnemyKind, int> m{EnemyKind::Goblin, 1};
+                    if (parts.empty() || parts.size() > 2 || !parseKind(parts[0], m.first) ||
+                        (parts.size() == 2 && (!parseInt(parts[1], m.second) || m.second <= 0))) {
+                        fail("bad mix entry '" + entry + "'");
+                    }
+                    w.mix.push_back(m);
+                }
+                if (w.mix.empty()) fail("empty mix");
+            } else if (key == "lanes") {
+                w.lanes.clear();
+                for (const std::string& name : split(value, ',')) {
+                    SpawnLane lane;
+                    if (!parseLane(name, lane)) fail("bad lane '" + name + "'");
+                    w.lanes.push_back(lane);
+                }
+                if (w.lanes.empty()) fail("empty lanes");
+            } else {
+                fail("unknown key '" + key + "'");
+            }
+        }
+
+        if (!haveCount) fail("wave needs count=");
+        if (!haveInterval) fail("wave needs interval=");
+        std::string why = checkWave(w);
+        if (!why.empty()) fail(why);
+        spawns += w.count; // both at most MAX_SPAWNS, no overflow
+        if (spawns > MAX_SPAWNS) fail("more than " + std::to_string(MAX_SPAWNS) + " enemies in all");
+        waves.push_back(std::move(w));
+    }
+    return waves;
+}
+
+std::vector<WaveDef> WaveSchedule::loadFile(const char* path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw ResourceError(std::string("Failed to open waves file: ") + path);
+    }
+    return parse(file, path);
+}
+
+WaveDef WaveSchedule::defaultWave(int prepTicks, int levelTicks) {
+    WaveDef w;
+    // The old timer started counting when prep ended and fired on its 150th tick
+    w.startTick = prepTicks + DEFAULT_SPAWN_INTERVAL - 1;
+    w.intervalTicks = DEFAULT_SPAWN_INTERVAL;
+    w.count = w.startTick < levelTicks ? (levelTicks - 1 - w.startTick) / w.intervalTicks + 1 : 0;
+    w.burst = 1;
+    w.mix = defaultMix();
+    w.lanes = allLanes();
+    return w;
+}
+
+void WaveSchedule::compile(const std::vector<WaveDef>& waves, Random& rng, int worldWidth, int worldHeight) {
+    events.clear();
+    cursor = 0;
+
+    size_t total = 0;
+    for (const WaveDef& w : waves) {
+        if (checkWave(w).empty()) total += static_cast<size_t>(w.count);
+    }
+    events.reserve(total);
+
+    for (const WaveDef& w : waves) {
+        if (!checkWave(w).empty()) continue;
+        int totalWeight = 0;
+        for (const auto& m : w.mix) totalWeight += m.second;
+
+        for (int i = 0; i < w.count; ++i) {
+            SpawnEvent e{};
+            e.tick = w.startTick + (i / w.burst) * w.intervalTicks;
+
+            // Same draw order as the old per-tick spawner: lane, position, kind
+            SpawnLane lane = w.lanes[rng.nextBelow(static_cast<uint32_t>(w.lanes.size()))];
+            switch (lane) {
+                case SpawnLane::Top:    e.x = rng.range(0, worldWidth - 1); e.y = 0; break;
+                case SpawnLane::Bottom: e.x = rng.range(0, worldWidth - 1); e.y = worldHeight; break;
+                case SpawnLane::Left:   e.x = 0; e.y = rng.range(0, worldHeight - 1); break;
+                case SpawnLane::Right:  e.x = worldWidth; e.y = rng.range(0, worldHeight - 1); break;
+            }
+
+            int pick = static_cast<int>(rng.nextBelow(static_cast<uint32_t>(totalWeight)));
+            e.kind = w.mix.back().first;
+            for (const auto& m : w.mix) {
+                if (pick < m.second) {
+                    e.kind = m.first;
+                    break;
+                }
+                pick -= m.second;
+            }
+            events.push_back(e);
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const SpawnEvent& a, const SpawnEvent& b) {
+        return a.tick < b.tick;
+    });
+}
+
+void WaveSchedule::write(ByteWriter& out, const std::vector<WaveDef>& waves) {
+    out.varint(waves.size());
+    for (const WaveDef& wave : waves) {
+        out.sint(wave.startTick);
+        out.sint(wave.count);
+        out.sint(wave.intervalTicks);
+        out.sint(wave.burst);
+        out.varint(wave.mix.size());
+        for (const auto& [kind, weight] : wave.mix) {
+            out.byte(static_cast<uint8_t>(kind));
+            out.sint(weight);
+        }
+        out.varint(wave.lanes.size());
+        for (SpawnLane lane : wave.lanes) out.byte(static_cast<uint8_t>(lane));
+    }
+}
+
+std::vector<WaveDef> WaveSchedule::read(ByteReader& in) {
+    constexpr uint64_t MAX_ITEMS = 1u << 16;
+    std::vector<WaveDef> waves(in.count(MAX_ITEMS, "waves"));
+    int spawns = 0;
+    for (WaveDef& wave : waves) {
+        wave.startTick = in.sint();
+        wave.count = in.sint();
+        wave.intervalTicks = in.sint();
+        wave.burst = in.sint();
+        wave.mix.resize(in.count(MAX_ITEMS, "mix entries"));
+        for (auto& [kind, weight] : wave.mix) {
+            uint8_t k = in.byte();
+            if (k > static_cast<uint8_t>(EnemyKind::Orc)) in.fail("unknown enemy kind");
+            kind = static_cast<EnemyKind>(k);
+            weight = in.sint();
+        }
+        wave.lanes.resize(in.count(MAX_ITEMS, "lanes"));
+        for (SpawnLane& lane : wave.lanes) {
+            uint8_t l = in.byte();
+            if (l > static_cast<uint8_t>(SpawnLane::Right)) in.fail("unknown spawn lane");
+            lane = static_cast<SpawnLane>(l);
+        }
+        // Same limits as a waves file: compile() relies on them
+        std::string why = checkWave(wave);
+        if (!why.empty()) in.fail("wave " + why);
+        spawns += wave.count;
+        if (spawns > MAX_SPAWNS) in.fail("too many enemies in waves");
+    }
+    return waves;
+}
@@ -1,59 +1,121 @@
 #include "Game.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
 #include "GameObject.h"
+#include "Level.hpp"
+#include <cstdlib>
+#include <cstring>
 
 Game *game = nullptr;
 
-int main() {
+// Most simulation ticks run before one rendered frame. When the host can't
+// keep up, the backlog beyond this is dropped instead of growing forever.
+#define MAX_TICKS_PER_FRAME 5
+// Render rate cap (for when vsync is unavailable)
+#define MAX_RENDER_FPS 144
+
+// Usage: tower-defense-2d [--tick-rate N] [--record FILE] [--replay FILE]
+// Gameplay is tuned for TICKS_PER_SECOND; another tick rate runs game time
+// proportionally faster or slower (--tick-rate 60 = double speed).
+// --record saves the session's inputs on exit; --replay plays one back
+// (F fast-forwards, tower-defense-sim --replay runs it headless).
+int main(int argc, char* argv[]) {
     Logger::getInstance().init("game_log.txt");
     
-    // const int FPS = 30; // Defined in Game loop usually or managed here
-    const int FPS = 30;
-    const int frameDelay = 1000 / FPS;
-
-
+    int tickRate = TICKS_PER_SECOND;
+    const char* recordFile = nullptr;
+    const char* replayFile = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[++i];
+        }
+    }
+    if (tickRate <= 0) tickRate = TICKS_PER_SECOND;
+    
+    const Uint64 tickNs = SDL_NS_PER_SECOND / tickRate;
+    const Uint64 minFrameNs = SDL_NS_PER_SECOND / MAX_RENDER_FPS;
+    // Fast-forward: keep ticking for about one frame of wall time, then draw
+    const Uint64 fastForwardBudgetNs = SDL_NS_PER_SECOND / 60;
 
     try {
         game = new Game();
         game->init("Game Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, false);
+        LOG_INFO(LogCategory::Game, "Simulation tick rate: %d/s", tickRate);
+        if (replayFile) {
+            if (!game->startReplay(replayFile)) LOG_WARN(LogCategory::Game, "Could not replay %s", replayFile);
+        } else if (recordFile) {
+            game->startRecording(recordFile);
+        }
 
 #ifdef GITHUB_ACTIONS
         const Uint32 maxRuntimeMs = 2000;
         const Uint32 startTicks = SDL_GetTicks();
 #endif
 
+        Uint64 previous = SDL_GetTicksNS();
+        Uint64 accumulator = 0;
         while (game->running()){
-            Uint32 frameStart = SDL_GetTicks(); 
-            game->handleEvents();
-            game->update();
-            game->render();
+            PROFILE_SCOPE("Frame");
+            Uint64 frameStart = SDL_GetTicksNS();
+            accumulator += frameStart - previous;
+            previous = frameStart;
+            
+            {
+                PROFILE_SCOPE("Game::handleEvents");
+                game->handleEvents();
+            }
+            
+            float alpha = 1.0f;
+            if (game->isFastForward()) {
+                // Max speed: as many ticks as fit in the budget, no interpolation
+                do {
+                    game->update();
+                } while (SDL_GetTicksNS() - frameStart < fastForwardBudgetNs);
+                accumulator = 0;
+            } else {
+                int ticks = 0;
+                while (accumulator >= tickNs && ticks < MAX_TICKS_PER_FRAME) {
+                    game->update();
+                    accumulator -= tickNs;
+                    ticks++;
+                }
+                if (accumulator >= tickNs) {
+                    // Spiral of death: drop the backlog, keep the sub-tick remainder
+                    LOG_DEBUG(LogCategory::Game, "Simulation behind, skipped %llu ticks",
+                              static_cast<unsigned long long>(accumulator / tickNs));
+                    accumulator %= tickNs;
+                }
+                alpha = static_cast<float>(accumulator) / static_cast<float>(tickNs);
+            }
+            
+            game->render(alpha);
 
-            int frameTime = SDL_GetTicks() - frameStart; 
-            if(frameDelay > frameTime)
+            Uint64 frameTime = SDL_GetTicksNS() - frameStart;
+            if (minFrameNs > frameTime)
             { 
-                SDL_Delay(frameDelay - frameTime);
+                SDL_DelayNS(minFrameNs - frameTime);
             }                                         
 
 #ifdef GITHUB_ACTIONS
             if (SDL_GetTicks() - startTicks > maxRuntimeMs) {
-                Logger::getInstance().log("CI time limit reached, exiting.");
+                LOG_INFO(LogCategory::Game, "CI time limit reached, exiting.");
                 break;
             }
 #endif
         }
     } catch (const GameException& e) {
-        std::string message("CRITICAL EXCEPTION: ");
-        message += e.what();
-        Logger::getInstance().log(message);
+        LOG_ERROR(LogCategory::General, "CRITICAL EXCEPTION: %s", e.what());
         std::cerr << "Game Crash: " << e.what() << std::endl;
         return -1;
     } catch (const std::exception& e) {
-        std::string message("STD EXCEPTION: ");
-        message += e.what();
-        Logger::getInstance().log(message);
+        LOG_ERROR(LogCategory::General, "STD EXCEPTION: %s", e.what());
         return -1;
     } catch (...) {
-        Logger::getInstance().log("UNKNOWN EXCEPTION");
+        LOG_ERROR(LogCategory::General, "UNKNOWN EXCEPTION");
         return -1;
     }
 
@@ -0,0 +1,201 @@
+// Headless simulation driver: runs Level::update without a window or
+// renderer, as fast as the CPU allows.
+//
+// Usage: tower-defense-sim [--frames N] [--seed S] [--tower COL,ROW[,basic|ice|fire]]... [--waves FILE]
+//                          [--map COLSxROWS] [--log FILE] [--log-level trace|debug|info|warn|error|off]
+//                          [--record FILE] [--replay FILE] [--save-snapshot FILE] [--load-snapshot FILE]
+//                          [--threads N] [--trace FILE] [--profile-csv FILE]   (ENABLE_PROFILER builds)
+//
+// --record saves the run's inputs (the --tower placements) as a replay;
+// --replay runs a recorded session (from the game or the simulator) to its
+// last tick instead, ignoring --seed/--map/--waves/--tower.
+// --save-snapshot writes the level's state after the run; --load-snapshot
+// starts from such a checkpoint and runs --frames more ticks.
+// --threads runs the AI query passes on a pool of N workers (0: one per
+// core); the results are the same as without it.
+
+#include "Level.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "GameObject.h"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool parseLogLevel(const char* arg, LogLevel& out) {
+    static const char* names[] = {"trace", "debug", "info", "warn", "error", "off"};
+    for (int i = 0; i <= static_cast<int>(LogLevel::Off); i++) {
+        if (std::strcmp(arg, names[i]) == 0) {
+            out = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseMapSize(const char* arg, int& cols, int& rows) {
+    char tail = 0;
+    return std::sscanf(arg, "%dx%d%c", &cols, &rows, &tail) == 2 && cols > 0 && rows > 0;
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: tower-defense-sim [--frames N] [--seed S] [--tower COL,ROW[,basic|ice|fire]]... [--waves FILE]\n"
+        "                         [--map COLSxROWS] [--log FILE] [--log-level trace|debug|info|warn|error|off]\n"
+        "                         [--record FILE] [--replay FILE] [--save-snapshot FILE] [--load-snapshot FILE]\n"
+        "                         [--threads N] [--trace FILE] [--profile-csv FILE]\n");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int frames = 30 * 60;
+    bool framesSet = false;
+    uint64_t seed = Random::DEFAULT_SEED;
+    std::string logFile = "sim_log.txt";
+    LogLevel logLevel = LogLevel::Info;
+    std::string traceFile;
+    std::string wavesFile;
+    std::string profileCsv;
+    std::string recordFile;
+    std::string replayFile;
+    std::string saveSnapshotFile;
+    std::string loadSnapshotFile;
+    std::vector<TowerPlacement> towers;
+    int mapCols = Map::DEFAULT_COLS;
+    int mapRows = Map::DEFAULT_ROWS;
+    bool threaded = false;
+    size_t threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+            framesSet = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--tower" && i + 1 < argc) {
+            TowerPlacement t{};
+            if (!TowerFactory::parsePlacement(argv[++i], t)) {
+                std::fprintf(stderr, "Invalid tower spec: %s\n", argv[i]);
+                return 1;
+            }
+            towers.push_back(t);
+        } else if (arg == "--log" && i + 1 < argc) {
+            logFile = argv[++i];
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            if (!parseLogLevel(argv[++i], logLevel)) {
+                std::fprintf(stderr, "Invalid log level: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--map" && i + 1 < argc) {
+            if (!parseMapSize(argv[++i], mapCols, mapRows)) {
+                std::fprintf(stderr, "Invalid map size: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--waves" && i + 1 < argc) {
+            wavesFile = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (arg == "--save-snapshot" && i + 1 < argc) {
+            saveSnapshotFile = argv[++i];
+        } else if (arg == "--load-snapshot" && i + 1 < argc) {
+            loadSnapshotFile = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threaded = true;
+            threads = std::strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "--profile-csv" && i + 1 < argc) {
+            profileCsv = argv[++i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Logger::getInstance().init(logFile);
+    Logger::getInstance().setMinLevel(logLevel);
+    
+    if (!ENABLE_PROFILER && (!traceFile.empty() || !profileCsv.empty())) {
+        std::fprintf(stderr, "Profiler not compiled in (configure with -DENABLE_PROFILER=ON); ignoring --trace/--profile-csv\n");
+    }
+    Profiler& profiler = Profiler::getInstance();
+    if (!traceFile.empty()) profiler.startTrace();
+
+    try {
+        std::unique_ptr<ThreadPool> pool;
+        if (threaded) pool = std::make_unique<ThreadPool>(threads);
+        Level level(nullptr, 1, seed);
+        level.setThreadPool(pool.get());
+        if (!replayFile.empty()) {
+            InputLog log = InputLog::loadFile(replayFile.c_str());
+            if (!framesSet) frames = log.getEndTick();
+            level.startPlayback(std::move(log));
+        } else if (!loadSnapshotFile.empty()) {
+            level.restoreSnapshot(LevelSnapshot::loadFile(loadSnapshotFile.c_str()));
+        } else {
+            level.loadDefaultMap(mapCols, mapRows);
+            if (!wavesFile.empty() && !level.loadWaves(wavesFile.c_str())) {
+                std::fprintf(stderr, "Could not load waves from %s; using the built-in wave\n", wavesFile.c_str());
+            }
+            if (!recordFile.empty()) level.startRecording();
+
+            for (const auto& t : towers) {
+                level.selectTowerType(t.type);
+                level.placeTower(t.col, t.row);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int ran = 0;
+        while (ran < frames && !level.isGameOver()) {
+            level.update();
+            ran++;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        if (level.isRecording()) {
+            InputLog log = level.stopRecording();
+            log.save(recordFile.c_str());
+            std::printf("Recorded %zu inputs over %d ticks to %s\n", log.size(), log.getEndTick(), recordFile.c_str());
+        }
+
+        if (!saveSnapshotFile.empty()) {
+            LevelSnapshot snapshot;
+            level.saveSnapshot(snapshot);
+            snapshot.save(saveSnapshotFile.c_str());
+            std::printf("Saved tick %d (%zu bytes) to %s\n", level.getFrame(), snapshot.size(), saveSnapshotFile.c_str());
+        }
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double fps = seconds > 0.0 ? ran / seconds : 0.0;
+        std::cout << level << "\n";
+        std::printf("Simulated %d frames in %.3f ms (%.0f frames/s)\n", ran, seconds * 1000.0, fps);
+        
+        for (const auto& s : profiler.getStats()) {
+            std::printf("  %-16s n=%-6llu min %8.2f us  avg %8.2f us  p99 %8.2f us\n", s.name.c_str(),
+                        static_cast<unsigned long long>(s.count), s.minUs, s.avgUs, s.p99Us);
+        }
+        if (!traceFile.empty()) {
+            profiler.stopTrace();
+            profiler.writeChromeTrace(traceFile.c_str());
+        }
+        if (!profileCsv.empty()) profiler.writeCsv(profileCsv.c_str());
+    } catch (const GameException& e) {
+        std::cerr << "Simulation failed: " << e.what() << std::endl;
+        return -1;
+    }
+
+    Logger::getInstance().close();
+    return 0;
+}
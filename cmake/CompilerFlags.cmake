@@ -30,6 +30,28 @@ function(set_compiler_flags)
             target_compile_options(${TARGET_NAME} PRIVATE /W4 /permissive- /wd4244 /wd4267 /wd4996 /external:anglebrackets /external:W0 /utf-8 /MP)
         else()
             target_compile_options(${TARGET_NAME} PRIVATE -Wall -Wextra -pedantic)
+            # No FMA contraction: keeps the simulation bit-identical across compilers/CPUs
+            target_compile_options(${TARGET_NAME} PRIVATE -ffp-contract=off)
+        endif()
+
+        # LogLevel value matching the LOG_MIN_LEVEL name (see Logger.hpp)
+        set(log_levels TRACE DEBUG INFO WARN ERROR OFF)
+        list(FIND log_levels "${LOG_MIN_LEVEL}" log_level_index)
+        if(log_level_index EQUAL -1)
+            message(FATAL_ERROR "Unknown LOG_MIN_LEVEL '${LOG_MIN_LEVEL}' (expected one of ${log_levels})")
+        endif()
+        target_compile_definitions(${TARGET_NAME} PRIVATE LOG_MIN_LEVEL=${log_level_index})
+
+        if(ENABLE_PROFILER)
+            target_compile_definitions(${TARGET_NAME} PRIVATE ENABLE_PROFILER=1)
+        endif()
+
+        if(USE_AVX2)
+            if(MSVC)
+                target_compile_options(${TARGET_NAME} PRIVATE /arch:AVX2)
+            else()
+                target_compile_options(${TARGET_NAME} PRIVATE -mavx2)
+            endif()
         endif()
 
         ###############################################################################
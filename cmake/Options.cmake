@@ -4,6 +4,11 @@ option(PROJECT_WARNINGS_AS_ERRORS "Treat warnings as errors" OFF)
 option(USE_ASAN "Use Address Sanitizer" OFF)
 option(USE_MSAN "Use Memory Sanitizer" OFF)
 option(CMAKE_COLOR_DIAGNOSTICS "Enable color diagnostics" ON)
+option(USE_AVX2 "Build the SIMD kernels for AVX2 instead of baseline SSE2 (x86-64 only)" OFF)
+set(LOG_MIN_LEVEL "DEBUG" CACHE STRING "Lowest log level compiled in; calls below it are removed")
+set_property(CACHE LOG_MIN_LEVEL PROPERTY STRINGS TRACE DEBUG INFO WARN ERROR OFF)
+option(BUILD_BENCHMARKS "Build the benchmarks target (simulation micro/macro benchmarks)" ON)
+option(ENABLE_PROFILER "Compile in PROFILE_SCOPE timers, the F3 overlay and trace export" OFF)
 
 # ------------------------------------------------------------------------------
 # Dependency Configuration (Must be set GLOBAL SCOPE before FetchContent)